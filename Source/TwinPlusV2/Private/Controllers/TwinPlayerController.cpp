@@ -4,17 +4,33 @@
 #include "Core/AppModes.h"
 #include "Subsystems/GlobalServices.h"
 #include "Subsystems/SceneManagerSubsystem.h"
+#include "Subsystems/EventBusSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 void ATwinPlayerController::BeginPlay()
 {
     Super::BeginPlay();
 
-    if (UModeManagerSubsystem* ModeMgr = UGlobalServices::GetModeManager(this))
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
     {
-        ModeMgr->OnModeChanged.AddDynamic(this, &ATwinPlayerController::HandleModeChanged);
+        ModeChangedHandle = EventBus->Subscribe(this, &ATwinPlayerController::HandleModeChangedEvent);
     }
 }
 
+void ATwinPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        EventBus->Unsubscribe(ModeChangedHandle);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ATwinPlayerController::HandleModeChangedEvent(const FModeChangedEvent& Event)
+{
+    HandleModeChanged(Event.NewMode);
+}
+
 void ATwinPlayerController::HandleModeChanged(EAppMode NewMode)
 {
     switch (NewMode)
@@ -5,3 +5,4 @@ DEFINE_LOG_CATEGORY(LogScene);
 
 DEFINE_LOG_CATEGORY(LogMode);
 DEFINE_LOG_CATEGORY(LogInputSys);
+DEFINE_LOG_CATEGORY(LogEventBus);
@@ -1,8 +1,12 @@
 #include "Core/TwinGameMode.h"
 #include "Controllers/TwinPlayerController.h"
 #include "Subsystems/ModeManagerSubsystem.h"
+#include "Subsystems/EventBusSubsystem.h"
+#include "Subsystems/GlobalServices.h"
 #include "Pawns/TwinCameraPawn.h"
 #include "Core/Logs.h"
+#include "Engine/World.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 ATwinGameMode::ATwinGameMode()
 {
@@ -18,45 +22,132 @@ void ATwinGameMode::BeginPlay()
     //RegisterExampleTools();
 }
 
+void ATwinGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (PostActorTickHandle.IsValid())
+    {
+        FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+        PostActorTickHandle.Reset();
+    }
+    PendingAppState.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ATwinGameMode::ApplyAppState(EAppState NewState)
 {
-    if (CurrentAppState == NewState)
-        return; 
+    ++DispatchStats.Requests;
+
+    if (PendingAppState.IsSet())
+    {
+        ++DispatchStats.Coalesced;
+    }
+
+    if (NewState == CurrentAppState)
+    {
+        // Back to the dispatched state before anyone saw the change
+        PendingAppState.Reset();
+        return;
+    }
+    PendingAppState = NewState;
+
+    if (!PostActorTickHandle.IsValid())
+    {
+        PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ATwinGameMode::HandlePostActorTick);
+    }
+}
+
+void ATwinGameMode::FlushAppState()
+{
+    if (!bDispatchingAppState)
+    {
+        DispatchAppState();
+    }
+}
+
+void ATwinGameMode::HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != GetWorld() || bDispatchingAppState)
+    {
+        return;
+    }
+
+    DispatchAppState();
+
+    if (!PendingAppState.IsSet() && PostActorTickHandle.IsValid())
+    {
+        FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+        PostActorTickHandle.Reset();
+    }
+}
+
+void ATwinGameMode::DispatchAppState()
+{
+    if (!PendingAppState.IsSet())
+    {
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(ATwinGameMode::DispatchAppState);
+
+    const EAppState NewState = PendingAppState.GetValue();
+    PendingAppState.Reset();
+    if (NewState == CurrentAppState)
+    {
+        return;
+    }
+
+    // Per game mode, so every world guards its own dispatch; ApplyAppState from a listener queues for the next frame
+    TGuardValue<bool> DispatchGuard(bDispatchingAppState, true);
 
+    const EAppState OldState = CurrentAppState;
     CurrentAppState = NewState;
-    OnAppStateChanged.Broadcast(NewState);
+    ++DispatchStats.Dispatches;
+    DispatchStats.LastListeners = OnAppStateChanged.GetAllObjects().Num();
 
-    UE_LOG(LogMode, Log, TEXT("AppState Changed: %d"), static_cast<uint8>(NewState));
+    const double ListenerStart = FPlatformTime::Seconds();
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        FAppStateChangedEvent Event;
+        Event.OldState = OldState;
+        Event.NewState = NewState;
+        EventBus->Publish(Event);
+    }
+    OnAppStateChanged.Broadcast(NewState);
+    const double ModeStart = FPlatformTime::Seconds();
 
     if (UGameInstance* GI = GetGameInstance())
     {
         if (UModeManagerSubsystem* ModeMgr = GI->GetSubsystem<UModeManagerSubsystem>())
         {
-            static bool bUpdatingMode = false;
-            if (!bUpdatingMode)
+            switch (NewState)
             {
-                bUpdatingMode = true;
-                switch (NewState)
-                {
-                    case EAppState::Explore:
-                        ModeMgr->SetMode(EAppMode::InGame);
-                        break;
-
-                    case EAppState::Simulation:
-                        ModeMgr->SetMode(EAppMode::Runtime);
-                        break;
-
-                    case EAppState::Edit:
-                        ModeMgr->SetMode(EAppMode::Editor);
-                        break;
-
-                    default:
-                        break;
-                }
-                bUpdatingMode = false;
+                case EAppState::Explore:
+                    ModeMgr->SetMode(EAppMode::InGame);
+                    break;
+
+                case EAppState::Simulation:
+                    ModeMgr->SetMode(EAppMode::Runtime);
+                    break;
+
+                case EAppState::Edit:
+                    ModeMgr->SetMode(EAppMode::Editor);
+                    break;
+
+                default:
+                    break;
             }
         }
     }
+
+    const double EndTime = FPlatformTime::Seconds();
+    DispatchStats.LastListenerMs = static_cast<float>((ModeStart - ListenerStart) * 1000.0);
+    DispatchStats.LastModeRequestMs = static_cast<float>((EndTime - ModeStart) * 1000.0);
+    DispatchStats.MaxDispatchMs = FMath::Max(DispatchStats.MaxDispatchMs, static_cast<float>((EndTime - ListenerStart) * 1000.0));
+
+    UE_LOG(LogMode, Log, TEXT("AppState Changed: %d (%d listeners %.3fms, mode request %.3fms, %d requests coalesced so far)"),
+        static_cast<uint8>(NewState), DispatchStats.LastListeners, DispatchStats.LastListenerMs,
+        DispatchStats.LastModeRequestMs, DispatchStats.Coalesced);
 }
 
 //void ATwinGameMode::RegisterExampleTools()
@@ -1,2 +1,28 @@
 #include "DataAssets/AppModeRegistry.h"
+#include "Core/Logs.h"
 
+void UAppModeRegistry::RebuildIndex()
+{
+    const int32 Duplicates = ModeIndex.Rebuild(Modes);
+    // Several entries may share a level, only the first is reachable by level
+    LevelIndex.Rebuild(Modes);
+
+    if (Duplicates > 0)
+    {
+        UE_LOG(LogMode, Warning, TEXT("%s: %d duplicate entries, only the first of each is used"), *GetName(), Duplicates);
+    }
+}
+
+void UAppModeRegistry::PostLoad()
+{
+    Super::PostLoad();
+    RebuildIndex();
+}
+
+#if WITH_EDITOR
+void UAppModeRegistry::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    RebuildIndex();
+}
+#endif
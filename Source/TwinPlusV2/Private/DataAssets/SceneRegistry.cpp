@@ -1,4 +1,28 @@
+#include "DataAssets/SceneRegistry.h"
+#include "Core/Logs.h"
 
+void USceneRegistry::RebuildIndex()
+{
+    const int32 Duplicates = SceneIndex.Rebuild(Scenes);
+    // Several entries may share a level, only the first is reachable by level
+    LevelIndex.Rebuild(Scenes);
 
-#include "DataAssets/SceneRegistry.h"
+    if (Duplicates > 0)
+    {
+        UE_LOG(LogScene, Warning, TEXT("%s: %d duplicate entries, only the first of each is used"), *GetName(), Duplicates);
+    }
+}
+
+void USceneRegistry::PostLoad()
+{
+    Super::PostLoad();
+    RebuildIndex();
+}
 
+#if WITH_EDITOR
+void USceneRegistry::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    RebuildIndex();
+}
+#endif
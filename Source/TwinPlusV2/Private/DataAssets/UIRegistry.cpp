@@ -1,3 +1,26 @@
-
 #include "DataAssets/UIRegistry.h"
+#include "Core/Logs.h"
+
+void UUIRegistry::RebuildIndex()
+{
+    const int32 Duplicates = EntryIndex.Rebuild(UIEntries);
+
+    if (Duplicates > 0)
+    {
+        UE_LOG(LogUI, Warning, TEXT("%s: %d duplicate entries, only the first of each is used"), *GetName(), Duplicates);
+    }
+}
+
+void UUIRegistry::PostLoad()
+{
+    Super::PostLoad();
+    RebuildIndex();
+}
 
+#if WITH_EDITOR
+void UUIRegistry::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    RebuildIndex();
+}
+#endif
@@ -0,0 +1 @@
+#include "PooledWidget.h"
@@ -0,0 +1,307 @@
+#include "Subsystems/EventBusSubsystem.h"
+#include "Subsystems/GlobalServices.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Core/Logs.h"
+
+namespace EventBusConsole
+{
+    static FAutoConsoleCommandWithWorldAndArgs DumpListenersCommand(
+        TEXT("Twin.Events.DumpListeners"),
+        TEXT("Logs every event bus listener with its call count and time, slowest first"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(World);
+            if (!EventBus)
+            {
+                return;
+            }
+
+            for (const FTwinEventListenerStats& Stats : EventBus->GetListenerStats())
+            {
+                UE_LOG(LogEventBus, Display, TEXT("%s -> %s [topic %s, priority %d, %s]: %d calls, %.3fms total, %.3fms max"),
+                    *Stats.EventName.ToString(), *Stats.ListenerName.ToString(), *Stats.Topic.ToString(), Stats.Priority,
+                    Stats.Delivery == ETwinEventDelivery::Immediate ? TEXT("immediate") : TEXT("end of frame"),
+                    Stats.Calls, Stats.TotalMs, Stats.MaxMs);
+            }
+        }));
+}
+
+void UEventBusSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UEventBusSubsystem::HandleEndFrame);
+}
+
+void UEventBusSubsystem::Deinitialize()
+{
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    EndFrameHandle.Reset();
+
+    Queue.Empty();
+    PendingListeners.Empty();
+    Channels.Empty();
+
+    Super::Deinitialize();
+}
+
+FTwinEventHandle UEventBusSubsystem::AddListener(FName EventName, FName ListenerName, FName Topic, int32 Priority,
+    ETwinEventDelivery Delivery, const UObject* Owner, TFunction<void(const void*)> Callback)
+{
+    FListener Listener;
+    Listener.Id = NextListenerId++;
+    Listener.ListenerName = ListenerName;
+    Listener.Topic = Topic;
+    Listener.Priority = Priority;
+    Listener.Delivery = Delivery;
+    Listener.Owner = Owner;
+    Listener.bHasOwner = Owner != nullptr;
+    Listener.Callback = MoveTemp(Callback);
+
+    FTwinEventHandle Handle;
+    Handle.Id = Listener.Id;
+
+    if (DispatchDepth > 0)
+    {
+        PendingListeners.Emplace(EventName, MoveTemp(Listener));
+    }
+    else
+    {
+        InsertListener(EventName, MoveTemp(Listener));
+    }
+    return Handle;
+}
+
+void UEventBusSubsystem::InsertListener(FName EventName, FListener&& Listener)
+{
+    FChannel& Channel = Channels.FindOrAdd(EventName);
+    if (Listener.Delivery == ETwinEventDelivery::EndOfFrame)
+    {
+        ++Channel.NumBatched;
+    }
+
+    int32 Index = 0;
+    while (Index < Channel.Listeners.Num() && Channel.Listeners[Index].Priority >= Listener.Priority)
+    {
+        ++Index;
+    }
+    Channel.Listeners.Insert(MoveTemp(Listener), Index);
+}
+
+void UEventBusSubsystem::RemoveListener(FChannel& Channel, FListener& Listener)
+{
+    if (Listener.Id == 0)
+    {
+        return;
+    }
+
+    if (Listener.Delivery == ETwinEventDelivery::EndOfFrame)
+    {
+        --Channel.NumBatched;
+    }
+
+    // The callback may be the one running right now, it is destroyed on compaction
+    Listener.Id = 0;
+    Channel.bNeedsCompaction = true;
+    bNeedsCompaction = true;
+}
+
+void UEventBusSubsystem::Unsubscribe(FTwinEventHandle& Handle)
+{
+    if (!Handle.IsValid())
+    {
+        return;
+    }
+
+    const uint64 Id = Handle.Id;
+    Handle.Reset();
+
+    if (PendingListeners.RemoveAll([Id](const TPair<FName, FListener>& Pending) { return Pending.Value.Id == Id; }) > 0)
+    {
+        return;
+    }
+
+    for (auto& Pair : Channels)
+    {
+        for (FListener& Listener : Pair.Value.Listeners)
+        {
+            if (Listener.Id == Id)
+            {
+                RemoveListener(Pair.Value, Listener);
+                if (DispatchDepth == 0)
+                {
+                    ApplyPendingChanges();
+                }
+                return;
+            }
+        }
+    }
+}
+
+void UEventBusSubsystem::UnsubscribeAll(const UObject* Owner)
+{
+    if (!Owner)
+    {
+        return;
+    }
+
+    PendingListeners.RemoveAll([Owner](const TPair<FName, FListener>& Pending) { return Pending.Value.Owner == Owner; });
+
+    for (auto& Pair : Channels)
+    {
+        for (FListener& Listener : Pair.Value.Listeners)
+        {
+            if (Listener.bHasOwner && Listener.Owner == Owner)
+            {
+                RemoveListener(Pair.Value, Listener);
+            }
+        }
+    }
+
+    if (DispatchDepth == 0)
+    {
+        ApplyPendingChanges();
+    }
+}
+
+void UEventBusSubsystem::Dispatch(FChannel& Channel, FName EventName, FName Topic, const void* Event, ETwinEventDelivery Delivery)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UEventBusSubsystem::Dispatch);
+
+    ++DispatchDepth;
+
+    // Listeners are only appended or removed after the outermost dispatch, so indices and references hold
+    const int32 NumListeners = Channel.Listeners.Num();
+    for (int32 Index = 0; Index < NumListeners; ++Index)
+    {
+        FListener& Listener = Channel.Listeners[Index];
+        if (Listener.Id == 0 || Listener.Delivery != Delivery)
+        {
+            continue;
+        }
+        if (!Listener.Topic.IsNone() && Listener.Topic != Topic)
+        {
+            continue;
+        }
+        if (Listener.bHasOwner && !Listener.Owner.IsValid())
+        {
+            RemoveListener(Channel, Listener);
+            continue;
+        }
+
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        Listener.Callback(Event);
+        const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+
+        ++Listener.Calls;
+        Listener.TotalSeconds += Seconds;
+        Listener.MaxSeconds = FMath::Max(Listener.MaxSeconds, Seconds);
+
+        if (!Listener.bReportedSlow && Seconds * 1000.0 > SlowListenerMs)
+        {
+            Listener.bReportedSlow = true;
+            UE_LOG(LogEventBus, Warning, TEXT("EventBus: Listener %s took %.3fms for %s (topic %s)"),
+                *Listener.ListenerName.ToString(), Seconds * 1000.0, *EventName.ToString(), *Topic.ToString());
+        }
+    }
+
+    --DispatchDepth;
+    if (DispatchDepth == 0 && (bNeedsCompaction || PendingListeners.Num() > 0))
+    {
+        ApplyPendingChanges();
+    }
+}
+
+void UEventBusSubsystem::ApplyPendingChanges()
+{
+    if (bNeedsCompaction)
+    {
+        for (auto It = Channels.CreateIterator(); It; ++It)
+        {
+            FChannel& Channel = It.Value();
+            if (Channel.bNeedsCompaction)
+            {
+                Channel.Listeners.RemoveAll([](const FListener& Listener) { return Listener.Id == 0; });
+                Channel.bNeedsCompaction = false;
+            }
+            if (Channel.Listeners.IsEmpty())
+            {
+                It.RemoveCurrent();
+            }
+        }
+        bNeedsCompaction = false;
+    }
+
+    TArray<TPair<FName, FListener>> Pending = MoveTemp(PendingListeners);
+    PendingListeners.Reset();
+    for (TPair<FName, FListener>& Pair : Pending)
+    {
+        InsertListener(Pair.Key, MoveTemp(Pair.Value));
+    }
+}
+
+void UEventBusSubsystem::HandleEndFrame()
+{
+    if (Queue.IsEmpty())
+    {
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(UEventBusSubsystem::HandleEndFrame);
+
+    // Events published by batched listeners are delivered next frame
+    TArray<FQueuedEvent> Batch = MoveTemp(Queue);
+    Queue.Reset();
+
+    for (const FQueuedEvent& Queued : Batch)
+    {
+        if (FChannel* Channel = Channels.Find(Queued.EventName))
+        {
+            Dispatch(*Channel, Queued.EventName, Queued.Topic, Queued.Payload->Get(), ETwinEventDelivery::EndOfFrame);
+        }
+    }
+}
+
+TArray<FTwinEventListenerStats> UEventBusSubsystem::GetListenerStats() const
+{
+    TArray<FTwinEventListenerStats> Result;
+    for (const auto& Pair : Channels)
+    {
+        for (const FListener& Listener : Pair.Value.Listeners)
+        {
+            if (Listener.Id == 0)
+            {
+                continue;
+            }
+
+            FTwinEventListenerStats& Stats = Result.AddDefaulted_GetRef();
+            Stats.EventName = Pair.Key;
+            Stats.ListenerName = Listener.ListenerName;
+            Stats.Topic = Listener.Topic;
+            Stats.Priority = Listener.Priority;
+            Stats.Delivery = Listener.Delivery;
+            Stats.Calls = Listener.Calls;
+            Stats.TotalMs = static_cast<float>(Listener.TotalSeconds * 1000.0);
+            Stats.MaxMs = static_cast<float>(Listener.MaxSeconds * 1000.0);
+        }
+    }
+
+    Result.Sort([](const FTwinEventListenerStats& A, const FTwinEventListenerStats& B) { return A.TotalMs > B.TotalMs; });
+    return Result;
+}
+
+void UEventBusSubsystem::ResetListenerStats()
+{
+    for (auto& Pair : Channels)
+    {
+        for (FListener& Listener : Pair.Value.Listeners)
+        {
+            Listener.Calls = 0;
+            Listener.TotalSeconds = 0.0;
+            Listener.MaxSeconds = 0.0;
+            Listener.bReportedSlow = false;
+        }
+    }
+}
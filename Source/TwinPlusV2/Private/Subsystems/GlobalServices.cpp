@@ -4,6 +4,8 @@
 #include "Subsystems/ModeManagerSubsystem.h"
 #include "Subsystems/SceneManagerSubsystem.h"
 #include "Subsystems/InputManagerSubsystem.h"
+#include "Subsystems/EventBusSubsystem.h"
+#include "Subsystems/IconManagerSubsystem.h"
 
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
@@ -48,3 +50,19 @@ UTwinPluginManager* UGlobalServices::GetPluginManager(const UObject* WorldContex
         return GI->GetSubsystem<UTwinPluginManager>();
     return nullptr;
 }
+
+UEventBusSubsystem* UGlobalServices::GetEventBus(const UObject* WorldContext)
+{
+    if (!WorldContext || !WorldContext->GetWorld()) return nullptr;
+    if (UGameInstance* GI = WorldContext->GetWorld()->GetGameInstance())
+        return GI->GetSubsystem<UEventBusSubsystem>();
+    return nullptr;
+}
+
+UIconManagerSubsystem* UGlobalServices::GetIconManager(const UObject* WorldContext)
+{
+    if (!WorldContext || !WorldContext->GetWorld()) return nullptr;
+    if (UGameInstance* GI = WorldContext->GetWorld()->GetGameInstance())
+        return GI->GetSubsystem<UIconManagerSubsystem>();
+    return nullptr;
+}
@@ -0,0 +1,654 @@
+#include "Subsystems/IconManagerSubsystem.h"
+#include "Subsystems/GlobalServices.h"
+#include "Subsystems/ModeManagerSubsystem.h"
+#include "TwinPluginFramework/Core/TwinPluginManager.h"
+#include "Components/Image.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "CanvasItem.h"
+#include "CanvasTypes.h"
+#include "RHI.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Framework/Application/SlateApplication.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Core/Logs.h"
+
+namespace IconManagerConsole
+{
+    static FAutoConsoleCommandWithWorldAndArgs DumpIconsCommand(
+        TEXT("Twin.UI.DumpIcons"),
+        TEXT("Logs icon atlas occupancy, hits, loads and evictions"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (UIconManagerSubsystem* IconManager = UGlobalServices::GetIconManager(World))
+            {
+                const FIconAtlasStats Stats = IconManager->GetAtlasStats();
+                UE_LOG(LogUI, Display, TEXT("Icon atlas: %d/%d cells (%d pinned, %.1f MB), %d requests, %d atlas hits, %d loads (%d pending), %d packed, %d evicted, %d overflowed"),
+                    Stats.UsedCells, Stats.Cells, Stats.PinnedCells, Stats.AtlasBytes / (1024.0 * 1024.0), Stats.Requests,
+                    Stats.AtlasHits, Stats.Loads, Stats.PendingLoads, Stats.Packed, Stats.Evictions, Stats.Overflows);
+            }
+        }));
+}
+
+void UIconManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    EventBus = Collection.InitializeDependency<UEventBusSubsystem>();
+    if (EventBus)
+    {
+        ModeChangedHandle = EventBus->Subscribe(this, &UIconManagerSubsystem::HandleModeChanged);
+    }
+
+    // Icons are packed before Slate ticks, so entries set up last frame paint with theirs
+    if (FSlateApplication::IsInitialized())
+    {
+        SlatePreTickHandle = FSlateApplication::Get().OnPreTick().AddUObject(this, &UIconManagerSubsystem::HandleSlatePreTick);
+    }
+}
+
+void UIconManagerSubsystem::Deinitialize()
+{
+    if (SlatePreTickHandle.IsValid() && FSlateApplication::IsInitialized())
+    {
+        FSlateApplication::Get().OnPreTick().Remove(SlatePreTickHandle);
+    }
+    SlatePreTickHandle.Reset();
+
+    if (EventBus)
+    {
+        EventBus->Unsubscribe(ModeChangedHandle);
+    }
+
+    for (TPair<FSoftObjectPath, FIconLoad>& Load : Loads)
+    {
+        if (Load.Value.Handle.IsValid())
+        {
+            Load.Value.Handle->CancelHandle();
+        }
+    }
+    Loads.Empty();
+    Requests.Empty();
+    ReadyToPack.Empty();
+    ImageIcons.Empty();
+    ImagePins.Empty();
+    Cells.Empty();
+    FreeCells.Empty();
+    CellsByPath.Empty();
+    Atlas = nullptr;
+
+    Super::Deinitialize();
+}
+
+void UIconManagerSubsystem::SetImageIcon(UImage* Image, TSoftObjectPtr<UTexture2D> Icon)
+{
+    if (!Image)
+    {
+        return;
+    }
+
+    const FSoftObjectPath Path = Icon.ToSoftObjectPath();
+    FImageIcon& ImageIcon = ImageIcons.FindOrAdd(Image);
+    if (ImageIcon.Image.Get() == Image && ImageIcon.Path == Path && !Path.IsNull())
+    {
+        // Already shown or on its way
+        return;
+    }
+
+    UnpinImage(ImageIcon);
+    ImageIcon.Image = Image;
+    ImageIcon.Path = Path;
+
+    // Hidden, not collapsed, so layouts do not shift when the icon arrives
+    Image->SetVisibility(ESlateVisibility::Hidden);
+    if (Path.IsNull())
+    {
+        ImageIcons.Remove(Image);
+        return;
+    }
+
+    ++ImagePins.FindOrAdd(Path);
+    const int32 RequestID = RequestIcon(Icon,
+        FOnIconReady::CreateUObject(this, &UIconManagerSubsystem::HandleImageIconReady, TWeakObjectPtr<UImage>(Image)));
+    if (FImageIcon* Tracked = ImageIcons.Find(Image))
+    {
+        Tracked->RequestID = RequestID;
+    }
+}
+
+void UIconManagerSubsystem::ClearImageIcon(UImage* Image)
+{
+    if (FImageIcon* ImageIcon = ImageIcons.Find(Image))
+    {
+        UnpinImage(*ImageIcon);
+        ImageIcons.Remove(Image);
+    }
+}
+
+void UIconManagerSubsystem::UnpinImage(FImageIcon& ImageIcon)
+{
+    if (ImageIcon.RequestID != 0)
+    {
+        CancelIconRequest(ImageIcon.RequestID);
+        ImageIcon.RequestID = 0;
+    }
+
+    if (int32* Pins = ImagePins.Find(ImageIcon.Path))
+    {
+        if (--(*Pins) <= 0)
+        {
+            ImagePins.Remove(ImageIcon.Path);
+        }
+    }
+    ImageIcon.Path.Reset();
+}
+
+void UIconManagerSubsystem::HandleImageIconReady(const FSlateBrush& Brush, TWeakObjectPtr<UImage> Image)
+{
+    UImage* Target = Image.Get();
+    if (!Target)
+    {
+        return;
+    }
+
+    if (FImageIcon* ImageIcon = ImageIcons.Find(Target))
+    {
+        ImageIcon->RequestID = 0;
+    }
+    Target->SetBrush(Brush);
+    Target->SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UIconManagerSubsystem::PurgeStaleImages()
+{
+    for (auto It = ImageIcons.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().Image.IsValid())
+        {
+            UnpinImage(It.Value());
+            It.RemoveCurrent();
+        }
+    }
+}
+
+bool UIconManagerSubsystem::GetIconBrush(TSoftObjectPtr<UTexture2D> Icon, FSlateBrush& OutBrush)
+{
+    const int32* Cell = CellsByPath.Find(Icon.ToSoftObjectPath());
+    if (!Cell)
+    {
+        return false;
+    }
+
+    Cells[*Cell].LastUsedFrame = GFrameCounter;
+    OutBrush = MakeCellBrush(*Cell);
+    return true;
+}
+
+int32 UIconManagerSubsystem::RequestIcon(const TSoftObjectPtr<UTexture2D>& Icon, FOnIconReady OnReady)
+{
+    const FSoftObjectPath Path = Icon.ToSoftObjectPath();
+    if (Path.IsNull())
+    {
+        return 0;
+    }
+
+    ++Stats.Requests;
+    if (const int32* Cell = CellsByPath.Find(Path))
+    {
+        ++Stats.AtlasHits;
+        Cells[*Cell].LastUsedFrame = GFrameCounter;
+        OnReady.ExecuteIfBound(MakeCellBrush(*Cell));
+        return 0;
+    }
+
+    const int32 RequestID = ++LastRequestID;
+    Requests.Add(RequestID, FIconRequest{ Path, MoveTemp(OnReady) });
+    StartLoad(Path, RequestID);
+    return RequestID;
+}
+
+void UIconManagerSubsystem::CancelIconRequest(int32 RequestID)
+{
+    FIconRequest Request;
+    if (!Requests.RemoveAndCopyValue(RequestID, Request))
+    {
+        return;
+    }
+
+    // Nobody waits for the icon any more, stop streaming it
+    FIconLoad* Load = Loads.Find(Request.Path);
+    if (Load && Load->RequestIDs.Remove(RequestID) > 0 && Load->RequestIDs.IsEmpty() && !Load->bPrewarm)
+    {
+        DropLoad(Request.Path);
+    }
+}
+
+void UIconManagerSubsystem::StartLoad(const FSoftObjectPath& Path, int32 RequestID)
+{
+    FIconLoad* Load = Loads.Find(Path);
+    if (!Load)
+    {
+        Load = &Loads.Add(Path);
+        if (UTexture2D* Resident = Cast<UTexture2D>(Path.ResolveObject()))
+        {
+            // Resident already, only needs packing
+            Resident->SetForceMipLevelsToBeResident(30.0f);
+            ReadyToPack.Add(Path);
+        }
+        else
+        {
+            StreamIcon(Path, *Load);
+        }
+    }
+
+    if (RequestID != 0)
+    {
+        Load->RequestIDs.Add(RequestID);
+    }
+    else
+    {
+        Load->bPrewarm = true;
+    }
+}
+
+void UIconManagerSubsystem::StreamIcon(const FSoftObjectPath& Path, FIconLoad& Load)
+{
+    ++Stats.Loads;
+    Load.bStreamed = true;
+    Load.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Path,
+        FStreamableDelegate::CreateUObject(this, &UIconManagerSubsystem::HandleIconLoaded, Path),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    // Nothing to load, the next pack reports it as failed
+    if (!Load.Handle.IsValid())
+    {
+        ReadyToPack.AddUnique(Path);
+    }
+}
+
+void UIconManagerSubsystem::HandleIconLoaded(FSoftObjectPath Path)
+{
+    if (!Loads.Contains(Path))
+    {
+        return;
+    }
+
+    // Streamed textures come in at a low mip, the atlas needs the full one
+    if (UTexture2D* Texture = Cast<UTexture2D>(Path.ResolveObject()))
+    {
+        Texture->SetForceMipLevelsToBeResident(30.0f);
+    }
+    ReadyToPack.AddUnique(Path);
+}
+
+void UIconManagerSubsystem::HandleSlatePreTick(float DeltaTime)
+{
+    if (ReadyToPack.Num() > 0)
+    {
+        PackReadyIcons();
+    }
+}
+
+void UIconManagerSubsystem::PackReadyIcons()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UIconManagerSubsystem::PackReadyIcons);
+
+    TArray<FSoftObjectPath> Paths = MoveTemp(ReadyToPack);
+    ReadyToPack.Reset();
+
+    struct FIconDraw
+    {
+        FSoftObjectPath Path;
+        UTexture2D* Texture = nullptr;
+        int32 Cell = INDEX_NONE;
+    };
+    TArray<FIconDraw> Draws;
+    TArray<FIconDraw> Overflowed;
+    TArray<FIconDraw> AlreadyPacked;
+
+    const bool bHasAtlas = EnsureAtlas();
+    for (const FSoftObjectPath& Path : Paths)
+    {
+        FIconLoad* Load = Loads.Find(Path);
+        if (!Load)
+        {
+            // Cancelled while waiting
+            continue;
+        }
+
+        if (const int32* Cell = CellsByPath.Find(Path))
+        {
+            AlreadyPacked.Add({ Path, nullptr, *Cell });
+            continue;
+        }
+
+        UTexture2D* Texture = Cast<UTexture2D>(Path.ResolveObject());
+        if (!Texture)
+        {
+            if (!Load->bStreamed)
+            {
+                // Was resident when requested but collected since
+                StreamIcon(Path, *Load);
+                continue;
+            }
+
+            UE_LOG(LogUI, Warning, TEXT("IconManager: Failed to load icon %s"), *Path.ToString());
+            DropLoad(Path);
+            continue;
+        }
+
+        // The full mip has to be resident before it is copied
+        if (Texture->HasPendingInitOrStreaming())
+        {
+            ReadyToPack.Add(Path);
+            continue;
+        }
+
+        const int32 Cell = bHasAtlas && Texture->GetResource() ? AllocateCell(Path) : INDEX_NONE;
+        if (Cell != INDEX_NONE)
+        {
+            Draws.Add({ Path, Texture, Cell });
+        }
+        else
+        {
+            Overflowed.Add({ Path, Texture, INDEX_NONE });
+        }
+    }
+
+    if (Draws.Num() > 0)
+    {
+        // One canvas pass for every icon that arrived this frame
+        FCanvas Canvas(Atlas->GameThread_GetRenderTargetResource(), nullptr, FGameTime::GetTimeSinceAppStart(), GMaxRHIFeatureLevel);
+        const FVector2D InnerSize(AtlasCellSize - 2 * AtlasCellPadding);
+        for (const FIconDraw& Draw : Draws)
+        {
+            const FVector2D Origin((Draw.Cell % CellsPerRow) * AtlasCellSize, (Draw.Cell / CellsPerRow) * AtlasCellSize);
+
+            // Opaque blending replaces what an evicted icon left, alpha included
+            FCanvasTileItem Clear(Origin, FVector2D(AtlasCellSize), FLinearColor::Transparent);
+            Clear.BlendMode = SE_BLEND_Opaque;
+            Canvas.DrawItem(Clear);
+
+            FCanvasTileItem Tile(Origin + FVector2D(AtlasCellPadding), Draw.Texture->GetResource(), InnerSize, FLinearColor::White);
+            Tile.BlendMode = SE_BLEND_Opaque;
+            Canvas.DrawItem(Tile);
+        }
+        Canvas.Flush_GameThread();
+        Stats.Packed += Draws.Num();
+    }
+
+    for (const FIconDraw& Draw : AlreadyPacked)
+    {
+        CompleteLoad(Draw.Path, MakeCellBrush(Draw.Cell));
+    }
+
+    for (const FIconDraw& Draw : Draws)
+    {
+        CompleteLoad(Draw.Path, MakeCellBrush(Draw.Cell));
+    }
+
+    for (const FIconDraw& Draw : Overflowed)
+    {
+        ++Stats.Overflows;
+        FSlateBrush Brush;
+        Brush.SetResourceObject(Draw.Texture);
+        Brush.ImageSize = FVector2D(Draw.Texture->GetSizeX(), Draw.Texture->GetSizeY());
+        CompleteLoad(Draw.Path, Brush);
+    }
+}
+
+void UIconManagerSubsystem::CompleteLoad(const FSoftObjectPath& Path, const FSlateBrush& Brush)
+{
+    FIconLoad Load;
+    if (!Loads.RemoveAndCopyValue(Path, Load))
+    {
+        return;
+    }
+
+    // The atlas holds the pixels now
+    if (Load.Handle.IsValid())
+    {
+        Load.Handle->ReleaseHandle();
+    }
+
+    // Callbacks may request or cancel icons, so they run once the bookkeeping is done
+    TArray<FOnIconReady> Callbacks;
+    for (const int32 RequestID : Load.RequestIDs)
+    {
+        FIconRequest Request;
+        if (Requests.RemoveAndCopyValue(RequestID, Request))
+        {
+            Callbacks.Add(MoveTemp(Request.OnReady));
+        }
+    }
+
+    for (const FOnIconReady& Callback : Callbacks)
+    {
+        Callback.ExecuteIfBound(Brush);
+    }
+}
+
+void UIconManagerSubsystem::DropLoad(const FSoftObjectPath& Path)
+{
+    FIconLoad Load;
+    if (!Loads.RemoveAndCopyValue(Path, Load))
+    {
+        return;
+    }
+
+    if (Load.Handle.IsValid())
+    {
+        Load.Handle->CancelHandle();
+    }
+
+    for (const int32 RequestID : Load.RequestIDs)
+    {
+        Requests.Remove(RequestID);
+    }
+    ReadyToPack.Remove(Path);
+}
+
+bool UIconManagerSubsystem::EnsureAtlas()
+{
+    if (Atlas)
+    {
+        return true;
+    }
+
+    if (!FApp::CanEverRender())
+    {
+        return false;
+    }
+
+    AtlasCellSize = FMath::Max(CellSize, 8);
+    AtlasCellPadding = FMath::Clamp(CellPadding, 0, AtlasCellSize / 4);
+    CellsPerRow = FMath::Max(AtlasSize / AtlasCellSize, 1);
+    const int32 Extent = CellsPerRow * AtlasCellSize;
+
+    Atlas = NewObject<UTextureRenderTarget2D>(this, TEXT("IconAtlas"));
+    Atlas->RenderTargetFormat = RTF_RGBA8_SRGB;
+    Atlas->ClearColor = FLinearColor::Transparent;
+    Atlas->bAutoGenerateMips = false;
+    Atlas->InitAutoFormat(Extent, Extent);
+    Atlas->UpdateResourceImmediate(true);
+
+    const int32 CellCount = CellsPerRow * CellsPerRow;
+    Cells.SetNum(CellCount);
+    FreeCells.Reset(CellCount);
+    // Handed out from the front
+    for (int32 Cell = CellCount - 1; Cell >= 0; --Cell)
+    {
+        FreeCells.Add(Cell);
+    }
+
+    Stats.AtlasBytes = static_cast<int64>(Extent) * Extent * 4;
+    UE_LOG(LogUI, Log, TEXT("IconManager: Created %dx%d icon atlas with %d cells of %d px"), Extent, Extent, CellCount, AtlasCellSize);
+    return true;
+}
+
+int32 UIconManagerSubsystem::AllocateCell(const FSoftObjectPath& Path)
+{
+    int32 Cell = FreeCells.Num() > 0 ? FreeCells.Pop(EAllowShrinking::No) : INDEX_NONE;
+    if (Cell == INDEX_NONE && Eviction == EIconAtlasEviction::LeastRecentlyUsed)
+    {
+        PurgeStaleImages();
+
+        // Icons used this frame or shown by a tracked image stay
+        uint64 OldestFrame = GFrameCounter;
+        for (int32 Index = 0; Index < Cells.Num(); ++Index)
+        {
+            if (Cells[Index].LastUsedFrame < OldestFrame && !ImagePins.Contains(Cells[Index].Path))
+            {
+                OldestFrame = Cells[Index].LastUsedFrame;
+                Cell = Index;
+            }
+        }
+
+        if (Cell != INDEX_NONE)
+        {
+            EvictCell(Cell);
+        }
+    }
+
+    if (Cell != INDEX_NONE)
+    {
+        Cells[Cell].Path = Path;
+        Cells[Cell].LastUsedFrame = GFrameCounter;
+        CellsByPath.Add(Path, Cell);
+    }
+    return Cell;
+}
+
+void UIconManagerSubsystem::EvictCell(int32 Cell)
+{
+    const FSoftObjectPath Path = Cells[Cell].Path;
+    CellsByPath.Remove(Path);
+    Cells[Cell] = FAtlasCell();
+    ++Stats.Evictions;
+
+    OnIconEvicted.Broadcast(Path);
+}
+
+FSlateBrush UIconManagerSubsystem::MakeCellBrush(int32 Cell) const
+{
+    const float Extent = static_cast<float>(CellsPerRow * AtlasCellSize);
+    const float InnerSize = static_cast<float>(AtlasCellSize - 2 * AtlasCellPadding);
+    const FVector2f Min((Cell % CellsPerRow) * AtlasCellSize + AtlasCellPadding, (Cell / CellsPerRow) * AtlasCellSize + AtlasCellPadding);
+
+    FSlateBrush Brush;
+    Brush.SetResourceObject(Atlas);
+    Brush.ImageSize = FVector2D(InnerSize);
+    Brush.SetUVRegion(FBox2f(Min / Extent, (Min + FVector2f(InnerSize)) / Extent));
+    return Brush;
+}
+
+void UIconManagerSubsystem::PrewarmIcons(const TArray<FSoftObjectPath>& Icons)
+{
+    if (!EnsureAtlas())
+    {
+        return;
+    }
+
+    // More than half the atlas would only evict what is on screen
+    const int32 Budget = Cells.Num() / 2;
+    int32 Started = 0;
+    for (const FSoftObjectPath& Path : Icons)
+    {
+        if (Path.IsNull() || CellsByPath.Contains(Path))
+        {
+            continue;
+        }
+
+        if (Started++ >= Budget)
+        {
+            UE_LOG(LogUI, Verbose, TEXT("IconManager: Prewarm stopped at %d icons, the atlas holds %d"), Budget, Cells.Num());
+            break;
+        }
+        StartLoad(Path, 0);
+    }
+}
+
+void UIconManagerSubsystem::PrewarmIconsForMode(EAppMode Mode)
+{
+    TSet<FSoftObjectPath> Icons;
+
+    UModeManagerSubsystem* ModeManager = UGlobalServices::GetModeManager(this);
+    if (const UAppModeRegistry* ModeRegistry = ModeManager ? ModeManager->GetModeRegistry() : nullptr)
+    {
+        for (const FAppModeEntry& Entry : ModeRegistry->Modes)
+        {
+            if (!Entry.Icon.IsNull())
+            {
+                Icons.Add(Entry.Icon.ToSoftObjectPath());
+            }
+        }
+    }
+
+    if (UTwinPluginManager* PluginManager = UGlobalServices::GetPluginManager(this))
+    {
+        for (const FRegisteredTool& Tool : PluginManager->GetRegisteredTools())
+        {
+            if (Tool.bEnabled && !Tool.Metadata.Icon.IsNull()
+                && (Tool.Metadata.SupportedModes.IsEmpty() || Tool.Metadata.SupportedModes.Contains(Mode)))
+            {
+                Icons.Add(Tool.Metadata.Icon.ToSoftObjectPath());
+            }
+        }
+    }
+
+    PrewarmIcons(Icons.Array());
+}
+
+void UIconManagerSubsystem::HandleModeChanged(const FModeChangedEvent& Event)
+{
+    if (bPrewarmModeIcons)
+    {
+        PrewarmIconsForMode(Event.NewMode);
+    }
+}
+
+void UIconManagerSubsystem::ClearAtlas()
+{
+    TArray<FSoftObjectPath> Evicted;
+    CellsByPath.GenerateKeyArray(Evicted);
+    Cells.Reset();
+    FreeCells.Reset();
+    CellsByPath.Reset();
+    Atlas = nullptr;
+    Stats.AtlasBytes = 0;
+
+    // Tracked images keep showing the old atlas until their icon is packed into the new one
+    PurgeStaleImages();
+    for (TPair<TObjectKey<UImage>, FImageIcon>& ImageIcon : ImageIcons)
+    {
+        if (ImageIcon.Value.RequestID == 0)
+        {
+            ImageIcon.Value.RequestID = RequestIcon(TSoftObjectPtr<UTexture2D>(ImageIcon.Value.Path),
+                FOnIconReady::CreateUObject(this, &UIconManagerSubsystem::HandleImageIconReady, ImageIcon.Value.Image));
+        }
+    }
+
+    for (const FSoftObjectPath& Path : Evicted)
+    {
+        OnIconEvicted.Broadcast(Path);
+    }
+}
+
+FIconAtlasStats UIconManagerSubsystem::GetAtlasStats() const
+{
+    FIconAtlasStats Result = Stats;
+    Result.Cells = Cells.Num();
+    Result.UsedCells = CellsByPath.Num();
+    Result.PendingLoads = Loads.Num();
+    for (const TPair<FSoftObjectPath, int32>& Pin : ImagePins)
+    {
+        if (CellsByPath.Contains(Pin.Key))
+        {
+            ++Result.PinnedCells;
+        }
+    }
+    return Result;
+}
@@ -1,6 +1,35 @@
 #include "Subsystems/ModeManagerSubsystem.h"
+#include "Subsystems/GlobalServices.h"
+#include "Subsystems/UIManagerSubsystem.h"
+#include "Subsystems/EventBusSubsystem.h"
+#include "TwinPluginFramework/Core/TwinPluginManager.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Core/Logs.h"
 #include "UObject/ConstructorHelpers.h"
+namespace ModeManagerConsole
+{
+    static FAutoConsoleCommandWithWorldAndArgs DumpAssetsCommand(
+        TEXT("Twin.Mode.DumpAssets"),
+        TEXT("Logs the handles, assets and estimated bytes held per mode"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UModeManagerSubsystem* ModeManager = UGlobalServices::GetModeManager(World);
+            if (!ModeManager)
+            {
+                return;
+            }
+
+            for (const FModeAssetReport& Report : ModeManager->GetModeAssetReport())
+            {
+                UE_LOG(LogMode, Display, TEXT("Mode %d: %d handles, %d assets, %.2f MB"),
+                    (int32)Report.Mode, Report.Handles, Report.Assets, Report.Bytes / (1024.0 * 1024.0));
+            }
+        }));
+}
+
 void UModeManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
@@ -25,6 +54,21 @@ void UModeManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     AllowedTransitions.Add(EAppMode::Runtime, {EAppMode::InGame});
 }
 
+void UModeManagerSubsystem::Deinitialize()
+{
+    CancelPrepare();
+
+    TArray<EAppMode> Modes;
+    ModeHandles.GetKeys(Modes);
+    for (const EAppMode Mode : Modes)
+    {
+        ReleaseModeHandles(Mode);
+    }
+    PendingLoads.Empty();
+
+    Super::Deinitialize();
+}
+
 bool UModeManagerSubsystem::CanTransition(EAppMode NewMode) const
 {
     if (CurrentMode == NewMode) return false;
@@ -34,12 +78,524 @@ bool UModeManagerSubsystem::CanTransition(EAppMode NewMode) const
 
 void UModeManagerSubsystem::SetMode(EAppMode Mode)
 {
+    if (IsTransitioning())
+    {
+        if (Mode == PendingMode) return;
+        if (Mode == CurrentMode)
+        {
+            UE_LOG(LogMode, Log, TEXT("ModeManagerSubsystem: Transition to %d cancelled, staying in %d"), (int32)PendingMode, (int32)CurrentMode);
+            CancelPrepare();
+            return;
+        }
+    }
+
     if (!CanTransition(Mode)) { UE_LOG(LogMode, Warning, TEXT("Cannot transition from %d to %d"), (int32)CurrentMode, (int32)Mode); return; }
     if (ModeRegistry && !ModeRegistry->FindMode(Mode)) { UE_LOG(LogMode, Warning, TEXT("Mode %d not found"), (int32)Mode); return; }
 
-    CurrentMode = Mode;
-    OnModeChanged.Broadcast(Mode);
-    UE_LOG(LogMode, Log, TEXT("ModeManagerSubsystem: Mode set to %d"), (int32)Mode);
+    BeginPrepare(Mode);
+}
+
+void UModeManagerSubsystem::BeginPrepare(EAppMode Mode)
+{
+    CancelPrepare();
+
+    PendingMode = Mode;
+    PrepareStage = 0;
+    PrepareStartTime = FPlatformTime::Seconds();
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        FModeTransitionStartedEvent Event;
+        Event.FromMode = CurrentMode;
+        Event.ToMode = Mode;
+        EventBus->Publish(Event);
+    }
+    OnModeTransitionStarted.Broadcast(CurrentMode, Mode);
+
+    if (bPrewarmTransitions)
+    {
+        RequestStage(Mode);
+    }
+    else
+    {
+        // Nothing to stream, commit on the first tick
+        PrepareStage = 1;
+    }
+
+    // Committed from the ticker even when everything is resident, so a burst of
+    // SetMode calls within one frame ends in a single OnModeChanged
+    TransitionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UModeManagerSubsystem::TickTransition));
+}
+
+bool UModeManagerSubsystem::RequestStage(EAppMode Mode)
+{
+    TArray<FSoftObjectPath> Paths;
+    if (PrepareStage == 0)
+    {
+        GatherModeAssets(Mode, Paths);
+    }
+    else if (UTwinPluginManager* PluginManager = UGlobalServices::GetPluginManager(this))
+    {
+        // Tool classes are resident now, their defaults name the widgets and icons
+        PluginManager->GetToolAssetsForMode(Mode, Paths);
+    }
+
+    if (Paths.IsEmpty())
+    {
+        return false;
+    }
+
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        Paths, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+    if (Handle.IsValid())
+    {
+        PrepareHandles.Add(Handle);
+    }
+    return Handle.IsValid();
+}
+
+void UModeManagerSubsystem::GatherModeAssets(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths)
+{
+    if (const FAppModeEntry* Entry = ModeRegistry ? ModeRegistry->FindMode(Mode) : nullptr)
+    {
+        if (!Entry->Icon.IsNull())
+        {
+            OutPaths.AddUnique(Entry->Icon.ToSoftObjectPath());
+        }
+
+        if (!Entry->Level.IsNull())
+        {
+            // A registered scene preloads hidden through the scene manager, anything else is just streamed into memory
+            USceneManagerSubsystem* SceneManager = UGlobalServices::GetSceneManager(this);
+            const FName SceneName = SceneManager ? SceneManager->FindSceneByLevel(FName(*Entry->Level.GetLongPackageName())) : NAME_None;
+            if (!SceneName.IsNone())
+            {
+                PrepareSceneRequest = SceneManager->PreloadScene(SceneName);
+            }
+            else
+            {
+                OutPaths.AddUnique(Entry->Level.ToSoftObjectPath());
+            }
+        }
+    }
+
+    if (UUIManagerSubsystem* UIManager = UGlobalServices::GetUIManager(this))
+    {
+        UIManager->GetWidgetClassesForMode(Mode, OutPaths);
+    }
+
+    if (UTwinPluginManager* PluginManager = UGlobalServices::GetPluginManager(this))
+    {
+        PluginManager->GetToolAssetsForMode(Mode, OutPaths);
+    }
+}
+
+bool UModeManagerSubsystem::IsPrepareComplete() const
+{
+    for (const TSharedPtr<FStreamableHandle>& Handle : PrepareHandles)
+    {
+        if (Handle->IsLoadingInProgress())
+        {
+            return false;
+        }
+    }
+
+    if (PrepareSceneRequest.IsValid())
+    {
+        if (USceneManagerSubsystem* SceneManager = UGlobalServices::GetSceneManager(this))
+        {
+            const ESceneRequestState State = SceneManager->GetSceneRequestState(PrepareSceneRequest);
+            if (State == ESceneRequestState::Loading || State == ESceneRequestState::MakingVisible)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+float UModeManagerSubsystem::GetTransitionProgress() const
+{
+    if (!IsTransitioning())
+    {
+        return 0.0f;
+    }
+
+    int32 Loaded = 0;
+    int32 Requested = 0;
+    for (const TSharedPtr<FStreamableHandle>& Handle : PrepareHandles)
+    {
+        int32 HandleLoaded = 0;
+        int32 HandleRequested = 0;
+        Handle->GetLoadedCount(HandleLoaded, HandleRequested);
+        Loaded += HandleLoaded;
+        Requested += HandleRequested;
+    }
+
+    float Progress = Requested > 0 ? static_cast<float>(Loaded) / Requested : 1.0f;
+    if (PrepareSceneRequest.IsValid())
+    {
+        if (USceneManagerSubsystem* SceneManager = UGlobalServices::GetSceneManager(this))
+        {
+            // The level counts as much as all other assets together
+            Progress = 0.5f * (Progress + SceneManager->GetSceneRequestProgress(PrepareSceneRequest));
+        }
+    }
+    return Progress;
+}
+
+bool UModeManagerSubsystem::TickTransition(float DeltaTime)
+{
+    if (!IsTransitioning())
+    {
+        TransitionTickerHandle.Reset();
+        return false;
+    }
+
+    if (IsPrepareComplete())
+    {
+        if (PrepareStage == 0)
+        {
+            PrepareStage = 1;
+            if (RequestStage(PendingMode) && !IsPrepareComplete())
+            {
+                return true;
+            }
+        }
+
+        CommitMode();
+        return false;
+    }
+
+    const double Elapsed = FPlatformTime::Seconds() - PrepareStartTime;
+    if (!bLoadingUIShown && !LoadingUIName.IsNone() && Elapsed >= LoadingUIDelay)
+    {
+        if (UUIManagerSubsystem* UIManager = UGlobalServices::GetUIManager(this))
+        {
+            UIManager->PushUI(LoadingUIName, LoadingUILayer);
+            bLoadingUIShown = true;
+        }
+    }
+
+    if (Elapsed > MaxPrepareSeconds)
+    {
+        UE_LOG(LogMode, Warning, TEXT("ModeManagerSubsystem: Mode %d not ready after %.1fs, switching anyway"), (int32)PendingMode, Elapsed);
+        CommitMode();
+        return false;
+    }
+
+    return true;
+}
+
+void UModeManagerSubsystem::CommitMode()
+{
+    if (TransitionTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TransitionTickerHandle);
+        TransitionTickerHandle.Reset();
+    }
+
+    const EAppMode OldMode = CurrentMode;
+    const EAppMode NewMode = PendingMode;
+    const double PrepareSeconds = PrepareStartTime > 0.0 ? FPlatformTime::Seconds() - PrepareStartTime : 0.0;
+    PendingMode = EAppMode::None;
+    PrepareStartTime = 0.0;
+    PrepareSceneRequest.Reset();
+
+    for (TSharedPtr<FStreamableHandle>& Handle : PrepareHandles)
+    {
+        AddModeHandle(NewMode, MoveTemp(Handle));
+    }
+    PrepareHandles.Reset();
+    HideLoadingUI();
+
+    CurrentMode = NewMode;
+
+    const double ListenerStart = FPlatformTime::Seconds();
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(UModeManagerSubsystem::ModeListeners);
+        if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+        {
+            FModeChangedEvent Event;
+            Event.OldMode = OldMode;
+            Event.NewMode = NewMode;
+            EventBus->Publish(Event);
+        }
+        OnModeChanged.Broadcast(NewMode);
+    }
+    const double ListenerSeconds = FPlatformTime::Seconds() - ListenerStart;
+
+    UE_LOG(LogMode, Log, TEXT("ModeManagerSubsystem: Mode set to %d (prepared in %.3fs, %d listeners %.3fms)"),
+        (int32)NewMode, PrepareSeconds, OnModeChanged.GetAllObjects().Num(), ListenerSeconds * 1000.0);
+
+    // Released after listeners switched over, assets shared with the new mode stay referenced by its handles
+    const int32 Released = ReleaseModeHandles(OldMode);
+    if (Released > 0 && bCollectGarbageOnModeExit && GEngine)
+    {
+        // Runs on the next tick, with incremental purge if the project enables it
+        GEngine->ForceGarbageCollection(false);
+    }
+}
+
+int32 UModeManagerSubsystem::ReleaseModeHandles(EAppMode Mode)
+{
+    HeldPaths.Remove(Mode);
+
+    TArray<TSharedPtr<FStreamableHandle>> Handles;
+    if (!ModeHandles.RemoveAndCopyValue(Mode, Handles))
+    {
+        return 0;
+    }
+
+    TArray<TFunction<void(UObject*)>> CancelledCallbacks;
+    for (const TSharedPtr<FStreamableHandle>& Handle : Handles)
+    {
+        if (Handle->IsLoadingInProgress())
+        {
+            Handle->CancelHandle();
+
+            // A cancelled handle never completes, its LoadForModeAsync requests are answered with null here
+            for (auto It = PendingLoads.CreateIterator(); It; ++It)
+            {
+                if (It->Value.Handle == Handle)
+                {
+                    CancelledCallbacks.Append(MoveTemp(It->Value.Callbacks));
+                    It.RemoveCurrent();
+                }
+            }
+        }
+        else
+        {
+            Handle->ReleaseHandle();
+        }
+    }
+
+    UE_LOG(LogMode, Log, TEXT("ModeManagerSubsystem: Released %d asset handles of mode %d"), Handles.Num(), (int32)Mode);
+
+    // After the bookkeeping, callbacks may start new loads
+    for (const TFunction<void(UObject*)>& Callback : CancelledCallbacks)
+    {
+        Callback(nullptr);
+    }
+    return Handles.Num();
+}
+
+UObject* UModeManagerSubsystem::LoadForMode(const FSoftObjectPath& Path)
+{
+    if (Path.IsNull())
+    {
+        return nullptr;
+    }
+
+    // The mode already keeps this asset, another handle would only be a duplicate
+    const TSet<FSoftObjectPath>* Held = HeldPaths.Find(CurrentMode);
+    if (Held && Held->Contains(Path))
+    {
+        if (UObject* Resident = Path.ResolveObject())
+        {
+            return Resident;
+        }
+    }
+
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestSyncLoad(Path);
+    if (!Handle.IsValid())
+    {
+        return Path.ResolveObject();
+    }
+
+    UObject* Asset = Handle->GetLoadedAsset();
+    AddModeHandle(CurrentMode, MoveTemp(Handle));
+    return Asset;
+}
+
+TSharedPtr<FStreamableHandle> UModeManagerSubsystem::RequestAsyncLoadForMode(const TArray<FSoftObjectPath>& Paths, FStreamableDelegate OnLoaded)
+{
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths, MoveTemp(OnLoaded));
+    AddModeHandle(CurrentMode, Handle);
+    return Handle;
+}
+
+void UModeManagerSubsystem::LoadForModeAsync(const FSoftObjectPath& Path, TFunction<void(UObject*)> OnLoaded)
+{
+    if (Path.IsNull())
+    {
+        OnLoaded(nullptr);
+        return;
+    }
+
+    if (Path.ResolveObject())
+    {
+        OnLoaded(LoadForMode(Path));
+        return;
+    }
+
+    // Only a load still in progress is shared, an entry without one is started over
+    FPendingModeLoad* Pending = PendingLoads.Find(Path);
+    if (Pending && Pending->Handle.IsValid() && Pending->Handle->IsLoadingInProgress())
+    {
+        Pending->Callbacks.Add(MoveTemp(OnLoaded));
+        ++SharedLoads;
+        UE_LOG(LogMode, Verbose, TEXT("ModeManagerSubsystem: %s already loading, %d requests shared so far"), *Path.ToString(), SharedLoads);
+        return;
+    }
+
+    FPendingModeLoad& NewLoad = PendingLoads.Add(Path);
+    NewLoad.Callbacks.Add(MoveTemp(OnLoaded));
+
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Path,
+        FStreamableDelegate::CreateUObject(this, &UModeManagerSubsystem::HandleAsyncLoadFinished, Path));
+    if (!Handle.IsValid())
+    {
+        // Nothing to load, the callbacks get null
+        HandleAsyncLoadFinished(Path);
+        return;
+    }
+
+    if (FPendingModeLoad* Added = PendingLoads.Find(Path))
+    {
+        Added->Handle = Handle;
+    }
+    AddModeHandle(CurrentMode, Handle);
+}
+
+void UModeManagerSubsystem::HandleAsyncLoadFinished(FSoftObjectPath Path)
+{
+    FPendingModeLoad Pending;
+    if (!PendingLoads.RemoveAndCopyValue(Path, Pending))
+    {
+        return;
+    }
+
+    UObject* Asset = Path.ResolveObject();
+    for (const TFunction<void(UObject*)>& Callback : Pending.Callbacks)
+    {
+        Callback(Asset);
+    }
+}
+
+void UModeManagerSubsystem::AddModeHandle(EAppMode Mode, TSharedPtr<FStreamableHandle> Handle)
+{
+    if (!Handle.IsValid())
+    {
+        return;
+    }
+
+    TArray<TSharedPtr<FStreamableHandle>>& Handles = ModeHandles.FindOrAdd(Mode);
+    TSet<FSoftObjectPath>& Held = HeldPaths.FindOrAdd(Mode);
+
+    // Completed handles stay active until released, so only handles released or cancelled
+    // by their requester drop out here. The paths they held no longer count as kept.
+    const int32 Removed = Handles.RemoveAll([](const TSharedPtr<FStreamableHandle>& Existing)
+    {
+        return !Existing->IsActive() && !Existing->IsLoadingInProgress();
+    });
+    if (Removed > 0)
+    {
+        Held.Reset();
+        TArray<FSoftObjectPath> Requested;
+        for (const TSharedPtr<FStreamableHandle>& Existing : Handles)
+        {
+            Requested.Reset();
+            Existing->GetRequestedAssets(Requested);
+            Held.Append(Requested);
+        }
+    }
+
+    TArray<FSoftObjectPath> Requested;
+    Handle->GetRequestedAssets(Requested);
+
+    // A completed handle for assets the mode already keeps adds nothing. Handles still loading
+    // are kept, releasing one would drop its completion delegate.
+    if (!Handle->IsLoadingInProgress() && Requested.Num() > 0)
+    {
+        bool bAllHeld = true;
+        for (const FSoftObjectPath& Path : Requested)
+        {
+            if (!Held.Contains(Path))
+            {
+                bAllHeld = false;
+                break;
+            }
+        }
+        if (bAllHeld)
+        {
+            Handle->ReleaseHandle();
+            return;
+        }
+    }
+
+    Held.Append(Requested);
+    Handles.Add(MoveTemp(Handle));
+}
+
+TArray<FModeAssetReport> UModeManagerSubsystem::GetModeAssetReport() const
+{
+    TArray<FModeAssetReport> Reports;
+    for (const auto& Pair : ModeHandles)
+    {
+        FModeAssetReport& Report = Reports.AddDefaulted_GetRef();
+        Report.Mode = Pair.Key;
+        Report.Handles = Pair.Value.Num();
+
+        TSet<UObject*> Assets;
+        for (const TSharedPtr<FStreamableHandle>& Handle : Pair.Value)
+        {
+            TArray<UObject*> Loaded;
+            Handle->GetLoadedAssets(Loaded);
+            for (UObject* Asset : Loaded)
+            {
+                bool bAlreadyCounted = false;
+                if (Asset)
+                {
+                    Assets.Add(Asset, &bAlreadyCounted);
+                }
+                if (Asset && !bAlreadyCounted)
+                {
+                    Report.Bytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+                }
+            }
+        }
+        Report.Assets = Assets.Num();
+    }
+
+    Reports.Sort([](const FModeAssetReport& A, const FModeAssetReport& B) { return A.Bytes > B.Bytes; });
+    return Reports;
+}
+
+void UModeManagerSubsystem::CancelPrepare()
+{
+    if (TransitionTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TransitionTickerHandle);
+        TransitionTickerHandle.Reset();
+    }
+
+    for (const TSharedPtr<FStreamableHandle>& Handle : PrepareHandles)
+    {
+        Handle->CancelHandle();
+    }
+    PrepareHandles.Empty();
+
+    // A scene that was preloaded for nothing stays in the scene manager's cache
+    PrepareSceneRequest.Reset();
+    PendingMode = EAppMode::None;
+    PrepareStartTime = 0.0;
+    HideLoadingUI();
+}
+
+void UModeManagerSubsystem::HideLoadingUI()
+{
+    if (!bLoadingUIShown)
+    {
+        return;
+    }
+
+    if (UUIManagerSubsystem* UIManager = UGlobalServices::GetUIManager(this))
+    {
+        // Other popups may have been pushed over it meanwhile
+        UIManager->RemoveUI(LoadingUIName, LoadingUILayer);
+    }
+    bLoadingUIShown = false;
 }
 
 const FAppModeEntry* UModeManagerSubsystem::GetCurrentModeEntry() const
@@ -0,0 +1,295 @@
+#include "Subsystems/SceneActorIndex.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+
+namespace SceneActorIndex
+{
+    template <typename KeyType, typename SetType>
+    static void RemoveFromBucket(TMap<KeyType, SetType>& Buckets, const KeyType& BucketKey, const TObjectKey<AActor>& ActorKey)
+    {
+        if (SetType* Bucket = Buckets.Find(BucketKey))
+        {
+            Bucket->Remove(ActorKey);
+            if (Bucket->IsEmpty())
+            {
+                Buckets.Remove(BucketKey);
+            }
+        }
+    }
+
+    template <typename MapType>
+    static int64 GetBucketBytes(const MapType& Buckets)
+    {
+        int64 Bytes = Buckets.GetAllocatedSize();
+        for (const auto& Pair : Buckets)
+        {
+            Bytes += Pair.Value.GetAllocatedSize();
+        }
+        return Bytes;
+    }
+}
+
+int32 FSceneActorIndex::AddLevel(ULevel* Level, FName SceneName)
+{
+    if (!Level || LevelActors.Contains(Level))
+    {
+        return 0;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    const TObjectKey<ULevel> LevelKey(Level);
+    LevelScenes.Add(LevelKey, SceneName);
+    LevelActors.Add(LevelKey).Reserve(Level->Actors.Num());
+    Actors.Reserve(Actors.Num() + Level->Actors.Num());
+
+    int32 Added = 0;
+    for (AActor* Actor : Level->Actors)
+    {
+        Added += AddActorInternal(Actor, SceneName) ? 1 : 0;
+    }
+
+    RecordUpdate(StartTime);
+    return Added;
+}
+
+int32 FSceneActorIndex::RemoveLevel(ULevel* Level)
+{
+    FActorSet LevelSet;
+    if (!LevelActors.RemoveAndCopyValue(Level, LevelSet))
+    {
+        return 0;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    for (const TObjectKey<AActor>& Key : LevelSet)
+    {
+        RemoveActorInternal(Key);
+    }
+    LevelScenes.Remove(Level);
+
+    RecordUpdate(StartTime);
+    return LevelSet.Num();
+}
+
+bool FSceneActorIndex::AddActor(AActor* Actor)
+{
+    ULevel* Level = Actor ? Actor->GetLevel() : nullptr;
+    if (!Level || !LevelActors.Contains(Level))
+    {
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Re-adding refreshes tags and metadata
+    RemoveActorInternal(TObjectKey<AActor>(Actor));
+    const bool bAdded = AddActorInternal(Actor, LevelScenes.FindRef(Level));
+
+    RecordUpdate(StartTime);
+    return bAdded;
+}
+
+bool FSceneActorIndex::RemoveActor(AActor* Actor)
+{
+    const TObjectKey<AActor> Key(Actor);
+    if (!Actors.Contains(Key))
+    {
+        return false;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    RemoveActorInternal(Key);
+    RecordUpdate(StartTime);
+    return true;
+}
+
+void FSceneActorIndex::Reset()
+{
+    Actors.Empty();
+    LevelActors.Empty();
+    LevelScenes.Empty();
+    ByClass.Empty();
+    ByTag.Empty();
+    ByScene.Empty();
+    ByMetadata.Empty();
+    ClassQueryCache.Empty();
+}
+
+bool FSceneActorIndex::AddActorInternal(AActor* Actor, FName SceneName)
+{
+    if (!IsValid(Actor))
+    {
+        return false;
+    }
+
+    const TObjectKey<AActor> Key(Actor);
+    FIndexedActor& Entry = Actors.Add(Key);
+    Entry.Class = Actor->GetClass();
+    Entry.Level = Actor->GetLevel();
+    Entry.SceneName = SceneName;
+    Entry.Tags = Actor->Tags;
+
+    LevelActors.FindOrAdd(Entry.Level).Add(Key);
+    ByScene.FindOrAdd(SceneName).Add(Key);
+
+    if (!ByClass.Contains(Entry.Class))
+    {
+        ClassQueryCache.Reset();
+    }
+    ByClass.FindOrAdd(Entry.Class).Add(Key);
+
+    const FString MetadataPrefix = MetadataKey.IsNone() ? FString() : MetadataKey.ToString() + TEXT("=");
+    for (const FName Tag : Entry.Tags)
+    {
+        ByTag.FindOrAdd(Tag).Add(Key);
+
+        if (!MetadataPrefix.IsEmpty() && Entry.MetadataValue.IsEmpty())
+        {
+            const FString TagString = Tag.ToString();
+            if (TagString.StartsWith(MetadataPrefix))
+            {
+                Entry.MetadataValue = TagString.Mid(MetadataPrefix.Len());
+                ByMetadata.FindOrAdd(Entry.MetadataValue).Add(Key);
+            }
+        }
+    }
+    return true;
+}
+
+void FSceneActorIndex::RemoveActorInternal(const TObjectKey<AActor>& Key)
+{
+    FIndexedActor Entry;
+    if (!Actors.RemoveAndCopyValue(Key, Entry))
+    {
+        return;
+    }
+
+    if (FActorSet* LevelSet = LevelActors.Find(Entry.Level))
+    {
+        LevelSet->Remove(Key);
+    }
+    SceneActorIndex::RemoveFromBucket(ByScene, Entry.SceneName, Key);
+    SceneActorIndex::RemoveFromBucket(ByClass, Entry.Class, Key);
+    for (const FName Tag : Entry.Tags)
+    {
+        SceneActorIndex::RemoveFromBucket(ByTag, Tag, Key);
+    }
+    if (!Entry.MetadataValue.IsEmpty())
+    {
+        SceneActorIndex::RemoveFromBucket(ByMetadata, Entry.MetadataValue, Key);
+    }
+}
+
+void FSceneActorIndex::RecordUpdate(double StartTime)
+{
+    LastUpdateSeconds = FPlatformTime::Seconds() - StartTime;
+    MaxUpdateSeconds = FMath::Max(MaxUpdateSeconds, LastUpdateSeconds);
+    ++Updates;
+}
+
+void FSceneActorIndex::Resolve(const FActorSet* Set, TArray<AActor*>& OutActors)
+{
+    if (!Set)
+    {
+        return;
+    }
+
+    OutActors.Reserve(OutActors.Num() + Set->Num());
+    for (const TObjectKey<AActor>& Key : *Set)
+    {
+        // Destroyed actors are dropped by the destroy handler, this only guards pending kill
+        AActor* Actor = Key.ResolveObjectPtr();
+        if (IsValid(Actor))
+        {
+            OutActors.Add(Actor);
+        }
+    }
+}
+
+void FSceneActorIndex::FindByClass(const UClass* Class, TArray<AActor*>& OutActors) const
+{
+    if (!Class)
+    {
+        return;
+    }
+
+    const TObjectKey<UClass> QueryKey(Class);
+    TArray<TObjectKey<UClass>>* Matches = ClassQueryCache.Find(QueryKey);
+    if (!Matches)
+    {
+        Matches = &ClassQueryCache.Add(QueryKey);
+        for (const auto& Pair : ByClass)
+        {
+            const UClass* Indexed = Pair.Key.ResolveObjectPtr();
+            if (Indexed && Indexed->IsChildOf(Class))
+            {
+                Matches->Add(Pair.Key);
+            }
+        }
+    }
+
+    for (const TObjectKey<UClass>& Match : *Matches)
+    {
+        Resolve(ByClass.Find(Match), OutActors);
+    }
+}
+
+void FSceneActorIndex::FindByTag(FName Tag, TArray<AActor*>& OutActors) const
+{
+    Resolve(ByTag.Find(Tag), OutActors);
+}
+
+void FSceneActorIndex::FindByScene(FName SceneName, TArray<AActor*>& OutActors) const
+{
+    Resolve(ByScene.Find(SceneName), OutActors);
+}
+
+void FSceneActorIndex::FindByMetadata(const FString& Value, TArray<AActor*>& OutActors) const
+{
+    Resolve(ByMetadata.Find(Value), OutActors);
+}
+
+AActor* FSceneActorIndex::FindFirstByMetadata(const FString& Value) const
+{
+    if (const FActorSet* Set = ByMetadata.Find(Value))
+    {
+        for (const TObjectKey<AActor>& Key : *Set)
+        {
+            AActor* Actor = Key.ResolveObjectPtr();
+            if (IsValid(Actor))
+            {
+                return Actor;
+            }
+        }
+    }
+    return nullptr;
+}
+
+FSceneActorIndexStats FSceneActorIndex::GetStats() const
+{
+    FSceneActorIndexStats Stats;
+    Stats.IndexedActors = Actors.Num();
+    Stats.IndexedLevels = LevelActors.Num();
+    Stats.Classes = ByClass.Num();
+    Stats.Tags = ByTag.Num();
+    Stats.MetadataValues = ByMetadata.Num();
+    Stats.Updates = Updates;
+    Stats.LastUpdateMs = static_cast<float>(LastUpdateSeconds * 1000.0);
+    Stats.MaxUpdateMs = static_cast<float>(MaxUpdateSeconds * 1000.0);
+
+    Stats.MemoryBytes = Actors.GetAllocatedSize() + LevelScenes.GetAllocatedSize() + ClassQueryCache.GetAllocatedSize();
+    for (const auto& Pair : Actors)
+    {
+        Stats.MemoryBytes += Pair.Value.Tags.GetAllocatedSize() + Pair.Value.MetadataValue.GetAllocatedSize();
+    }
+    for (const auto& Pair : ByMetadata)
+    {
+        Stats.MemoryBytes += Pair.Key.GetAllocatedSize();
+    }
+    Stats.MemoryBytes += SceneActorIndex::GetBucketBytes(LevelActors) + SceneActorIndex::GetBucketBytes(ByClass)
+        + SceneActorIndex::GetBucketBytes(ByTag) + SceneActorIndex::GetBucketBytes(ByScene)
+        + SceneActorIndex::GetBucketBytes(ByMetadata) + SceneActorIndex::GetBucketBytes(ClassQueryCache);
+    return Stats;
+}
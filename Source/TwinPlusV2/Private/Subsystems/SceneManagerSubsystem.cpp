@@ -1,6 +1,36 @@
 #include "Subsystems/SceneManagerSubsystem.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/GameInstance.h"
+#include "Misc/PackageName.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Async/Async.h"
+#include "Serialization/MemoryWriter.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Subsystems/GlobalServices.h"
+#include "Subsystems/EventBusSubsystem.h"
 #include "Core/Logs.h"
+
+namespace SceneManager
+{
+    // Finished request states kept around for GetSceneRequestState
+    static constexpr int32 MaxFinishedRequests = 256;
+
+    // Completed loads kept for the timeline export
+    static constexpr int32 MaxTimelineEntries = 512;
+}
+
 void USceneManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
@@ -17,65 +47,1711 @@ void USceneManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
         SceneRegistry = NewObject<USceneRegistry>(this);
         ensure(SceneRegistry);
     }
+
+    MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddUObject(this, &USceneManagerSubsystem::HandleMemoryTrim);
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &USceneManagerSubsystem::HandleLevelAddedToWorld);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &USceneManagerSubsystem::HandleLevelRemovedFromWorld);
+    WorldActorsInitializedHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(this, &USceneManagerSubsystem::HandleWorldActorsInitialized);
+    TelemetryStartTime = FPlatformTime::Seconds();
+
+    // Spilled snapshots only live as long as this subsystem, other instances (PIE clients, other processes) keep theirs
+    SnapshotSpillDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SceneSnapshots"), FGuid::NewGuid().ToString());
+}
+
+void USceneManagerSubsystem::Deinitialize()
+{
+    FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FWorldDelegates::OnWorldInitializedActors.Remove(WorldActorsInitializedHandle);
+    UnbindActorIndex();
+    SetSpatialStreamingEnabled(false);
+
+    if (SnapshotTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SnapshotTickerHandle);
+        SnapshotTickerHandle.Reset();
+    }
+    SnapshotCaptures.Empty();
+    TArray<FName> SnapshotScenes;
+    Snapshots.GetKeys(SnapshotScenes);
+    for (const FName SnapshotScene : SnapshotScenes)
+    {
+        DiscardSceneSnapshot(SnapshotScene);
+    }
+    IFileManager::Get().DeleteDirectory(*SnapshotSpillDir, false, true);
+
+    if (PollTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PollTickerHandle);
+        PollTickerHandle.Reset();
+    }
+
+    for (auto& Pair : ActiveRequests)
+    {
+        if (ULevelStreaming* Level = Pair.Value.StreamingLevel.Get())
+        {
+            Level->OnLevelLoaded.RemoveDynamic(this, &USceneManagerSubsystem::HandleStreamingLevelChanged);
+            Level->OnLevelShown.RemoveDynamic(this, &USceneManagerSubsystem::HandleStreamingLevelChanged);
+            Level->OnLevelHidden.RemoveDynamic(this, &USceneManagerSubsystem::HandleStreamingLevelChanged);
+            Level->OnLevelUnloaded.RemoveDynamic(this, &USceneManagerSubsystem::HandleStreamingLevelChanged);
+        }
+    }
+    ActiveRequests.Empty();
+
+    Super::Deinitialize();
 }
 
 const FSceneEntry* USceneManagerSubsystem::FindSceneEntry(FName SceneName) const
 {
-    if (!SceneRegistry) return nullptr;
-    for (const FSceneEntry& Entry : SceneRegistry->Scenes)
-        if (Entry.SceneName == SceneName) return &Entry;
-    return nullptr;
+    return SceneRegistry ? SceneRegistry->FindScene(SceneName) : nullptr;
 }
 
-void USceneManagerSubsystem::LoadScene(FName SceneName, bool bMakeVisible)
+FName USceneManagerSubsystem::FindSceneByLevel(FName LevelPackageName) const
 {
-    if (const FSceneEntry* Entry = FindSceneEntry(SceneName))
+    const FSceneEntry* Entry = SceneRegistry ? SceneRegistry->FindSceneByLevel(LevelPackageName) : nullptr;
+    return Entry ? Entry->SceneName : NAME_None;
+}
+
+ULevelStreaming* USceneManagerSubsystem::FindStreamingLevel(const FSceneEntry& Entry) const
+{
+    return UGameplayStatics::GetStreamingLevel(this, FName(*Entry.LevelPath.GetAssetName()));
+}
+
+FSceneRequestHandle USceneManagerSubsystem::LoadScene(FName SceneName, bool bMakeVisible)
+{
+    return StartRequest(SceneName, ESceneRequestType::Load, bMakeVisible);
+}
+
+FSceneRequestHandle USceneManagerSubsystem::UnloadScene(FName SceneName)
+{
+    return StartRequest(SceneName, ESceneRequestType::Unload, false);
+}
+
+FSceneRequestHandle USceneManagerSubsystem::PreloadScene(FName SceneName)
+{
+    if (SceneName == CurrentScene || PreloadedScenes.Contains(SceneName))
     {
-        FLatentActionInfo LatentInfo;
-        LatentInfo.CallbackTarget = this;
-        UGameplayStatics::LoadStreamLevel(this, FName(*Entry->LevelPath.GetAssetName()), bMakeVisible, false, LatentInfo);
+        return FSceneRequestHandle();
+    }
 
-        CurrentScene = SceneName;
-        OnSceneLoaded.Broadcast(SceneName);
-        UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Loaded scene %s"), *SceneName.ToString());
+    // Never downgrade a scene that is already on its way in or out
+    if (HasActiveRequest(SceneName))
+    {
+        return FSceneRequestHandle();
     }
-    else UE_LOG(LogScene, Warning, TEXT("Scene %s not found!"), *SceneName.ToString());
+
+    return StartRequest(SceneName, ESceneRequestType::Load, false, true);
 }
 
-void USceneManagerSubsystem::UnloadScene(FName SceneName)
+FSceneRequestHandle USceneManagerSubsystem::StartRequest(FName SceneName, ESceneRequestType Type, bool bMakeVisible, bool bPreload, bool bSpatialCell)
 {
-    if (const FSceneEntry* Entry = FindSceneEntry(SceneName))
+    TRACE_CPUPROFILER_EVENT_SCOPE(USceneManagerSubsystem::StartRequest);
+
+    const FSceneEntry* Entry = FindSceneEntry(SceneName);
+    if (!Entry)
+    {
+        UE_LOG(LogScene, Warning, TEXT("Scene %s not found!"), *SceneName.ToString());
+        return FSceneRequestHandle();
+    }
+
+    ULevelStreaming* Level = FindStreamingLevel(*Entry);
+    if (!Level)
+    {
+        UE_LOG(LogScene, Warning, TEXT("Scene %s is not a streaming level of the current world"), *SceneName.ToString());
+        return FSceneRequestHandle();
+    }
+
+    // A newer request for the same level supersedes the old one
+    CancelRequestsForScene(SceneName);
+
+    // The level is only hidden until the time sliced capture is done, its actors stay in the world for it
+    const bool bAwaitingSnapshot = Type == ESceneRequestType::Unload && bSnapshotOnUnload && Level->GetLoadedLevel()
+        && CaptureSceneState(SceneName);
+
+    if (Type == ESceneRequestType::Load)
+    {
+        ResolvePackageSize(SceneName, *Entry);
+    }
+
+    const bool bWasResident = Level->IsLevelLoaded();
+    if (Type == ESceneRequestType::Load && !bWasResident && bRestoreSnapshotOnLoad)
+    {
+        // Read and decompress while the package streams in
+        PrefetchSnapshot(SceneName);
+    }
+
+    FSceneRequest Request;
+    Request.Id = NextRequestId++;
+    Request.SceneName = SceneName;
+    Request.Type = Type;
+    Request.bMakeVisible = bMakeVisible;
+    Request.bPreload = bPreload;
+    Request.bSpatialCell = bSpatialCell;
+    Request.bWasResident = bWasResident;
+    Request.bAwaitingSnapshot = bAwaitingSnapshot;
+    Request.StreamingLevel = Level;
+    Request.RequestedTime = FPlatformTime::Seconds();
+    switch (Type)
+    {
+        case ESceneRequestType::Load:   Request.State = ESceneRequestState::Loading; break;
+        case ESceneRequestType::Unload: Request.State = ESceneRequestState::Unloading; break;
+        case ESceneRequestType::Hide:   Request.State = ESceneRequestState::Hiding; break;
+    }
+
+    Level->OnLevelLoaded.AddUniqueDynamic(this, &USceneManagerSubsystem::HandleStreamingLevelChanged);
+    Level->OnLevelShown.AddUniqueDynamic(this, &USceneManagerSubsystem::HandleStreamingLevelChanged);
+    Level->OnLevelHidden.AddUniqueDynamic(this, &USceneManagerSubsystem::HandleStreamingLevelChanged);
+    Level->OnLevelUnloaded.AddUniqueDynamic(this, &USceneManagerSubsystem::HandleStreamingLevelChanged);
+
+    if (Type == ESceneRequestType::Load)
+    {
+        Level->SetShouldBeLoaded(true);
+        Level->SetShouldBeVisible(bMakeVisible);
+    }
+    else if (Type == ESceneRequestType::Hide)
+    {
+        Level->SetShouldBeVisible(false);
+    }
+    else
+    {
+        Level->SetShouldBeVisible(false);
+        Level->SetShouldBeLoaded(bAwaitingSnapshot);
+    }
+
+    UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: %s requested for scene %s (request %d)"),
+        *StaticEnum<ESceneRequestType>()->GetNameStringByValue(static_cast<int64>(Type)), *SceneName.ToString(), Request.Id);
+
+    TRACE_BOOKMARK(TEXT("Scene %s requested: %s"),
+        *StaticEnum<ESceneRequestType>()->GetNameStringByValue(static_cast<int64>(Type)), *SceneName.ToString());
+
+    FSceneRequestHandle Handle;
+    Handle.RequestId = Request.Id;
+    ActiveRequests.Add(Request.Id, MoveTemp(Request));
+
+    // The level may already be in the requested state
+    UpdateRequests();
+    EnsurePolling();
+
+    return Handle;
+}
+
+void USceneManagerSubsystem::CancelRequestsForScene(FName SceneName)
+{
+    TArray<int32> ToCancel;
+    for (const auto& Pair : ActiveRequests)
+    {
+        if (Pair.Value.SceneName == SceneName)
+        {
+            ToCancel.Add(Pair.Key);
+        }
+    }
+
+    for (const int32 RequestId : ToCancel)
+    {
+        FinishRequest(RequestId, ESceneRequestState::Cancelled);
+    }
+}
+
+void USceneManagerSubsystem::HandleStreamingLevelChanged()
+{
+    UpdateRequests();
+}
+
+void USceneManagerSubsystem::UpdateRequests()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(USceneManagerSubsystem::UpdateRequests);
+
+    TArray<int32> Finished;
+    for (auto& Pair : ActiveRequests)
+    {
+        if (UpdateRequest(Pair.Value))
+        {
+            Finished.Add(Pair.Key);
+        }
+    }
+
+    for (const int32 RequestId : Finished)
+    {
+        const FSceneRequest* Request = ActiveRequests.Find(RequestId);
+        if (Request)
+        {
+            FinishRequest(RequestId, Request->State);
+        }
+    }
+}
+
+bool USceneManagerSubsystem::UpdateRequest(FSceneRequest& Request)
+{
+    ULevelStreaming* Level = Request.StreamingLevel.Get();
+    if (!Level)
+    {
+        Request.State = ESceneRequestState::Failed;
+        return true;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+
+    switch (Request.State)
+    {
+        case ESceneRequestState::Loading:
+            if (Level->IsLevelLoaded())
+            {
+                Request.FirstPhaseTime = Now;
+                TRACE_BOOKMARK(TEXT("Scene package loaded: %s"), *Request.SceneName.ToString());
+                Request.State = Request.bMakeVisible ? ESceneRequestState::MakingVisible : ESceneRequestState::Completed;
+                if (Request.State == ESceneRequestState::MakingVisible && Level->IsLevelVisible())
+                {
+                    Request.State = ESceneRequestState::Completed;
+                }
+            }
+            break;
+
+        case ESceneRequestState::MakingVisible:
+            if (Level->IsLevelVisible())
+            {
+                Request.State = ESceneRequestState::Completed;
+            }
+            break;
+
+        case ESceneRequestState::Hiding:
+            if (!Level->IsLevelVisible())
+            {
+                Request.FirstPhaseTime = Now;
+                Request.State = ESceneRequestState::Completed;
+            }
+            break;
+
+        case ESceneRequestState::Unloading:
+            if (Request.FirstPhaseTime == 0.0 && !Level->IsLevelVisible())
+            {
+                Request.FirstPhaseTime = Now;
+            }
+            if (!Level->IsLevelLoaded() && !Level->HasLoadRequestPending())
+            {
+                if (Request.FirstPhaseTime == 0.0)
+                {
+                    Request.FirstPhaseTime = Now;
+                }
+                Request.State = ESceneRequestState::Completed;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (Request.State == ESceneRequestState::Completed)
+    {
+        Request.CompletedTime = Now;
+        return true;
+    }
+
+    return false;
+}
+
+void USceneManagerSubsystem::FinishRequest(int32 RequestId, ESceneRequestState FinalState)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(USceneManagerSubsystem::FinishRequest);
+
+    FSceneRequest Request;
+    if (!ActiveRequests.RemoveAndCopyValue(RequestId, Request))
+    {
+        return;
+    }
+
+    Request.State = FinalState;
+    const bool bSuccess = FinalState == ESceneRequestState::Completed;
+
+    if (Request.bSpatialCell)
+    {
+        CellLoads.Remove(Request.SceneName);
+    }
+
+    FinishedRequests.Add(RequestId, FinalState);
+    if (FinishedRequests.Num() > SceneManager::MaxFinishedRequests)
+    {
+        // Ids increase monotonically, drop the oldest
+        int32 OldestId = MAX_int32;
+        for (const auto& Pair : FinishedRequests)
+        {
+            OldestId = FMath::Min(OldestId, Pair.Key);
+        }
+        FinishedRequests.Remove(OldestId);
+    }
+
+    // Listener cost is part of the load as far as the user is concerned
+    double ListenerSeconds = 0.0;
+    auto BroadcastTimed = [this, &ListenerSeconds](ESceneEventType Type, FName SceneName)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(USceneManagerSubsystem::SceneListeners);
+        const double Start = FPlatformTime::Seconds();
+        PublishSceneEvent(Type, SceneName);
+        ListenerSeconds = FPlatformTime::Seconds() - Start;
+    };
+
+    if (bSuccess)
+    {
+        // Before any listener sees the scene
+        if (Request.Type == ESceneRequestType::Load && !Request.bWasResident && bRestoreSnapshotOnLoad && Snapshots.Contains(Request.SceneName))
+        {
+            RestoreSceneState(Request.SceneName);
+        }
+
+        FScenePhaseTimings Timings;
+        Timings.SceneName = Request.SceneName;
+        Timings.Type = Request.Type;
+        Timings.FirstPhaseSeconds = static_cast<float>(Request.FirstPhaseTime - Request.RequestedTime);
+        Timings.SecondPhaseSeconds = static_cast<float>(Request.CompletedTime - Request.FirstPhaseTime);
+        Timings.TotalSeconds = static_cast<float>(Request.CompletedTime - Request.RequestedTime);
+
+        if (Request.Type == ESceneRequestType::Hide)
+        {
+            PreloadedScenes.Add(Request.SceneName);
+            ResidentLRU.Remove(Request.SceneName);
+            ResidentLRU.Add(Request.SceneName);
+            if (CurrentScene == Request.SceneName) CurrentScene = NAME_None;
+
+            UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Hid scene %s, kept resident (%.1f MB)"),
+                *Request.SceneName.ToString(), ResidentBytes.FindRef(Request.SceneName) / (1024.0 * 1024.0));
+            PublishSceneEvent(ESceneEventType::Hidden, Request.SceneName);
+
+            EnforceResidencyBudget();
+        }
+        else if (Request.Type == ESceneRequestType::Load && Request.bSpatialCell)
+        {
+            const int64 CellBytes = MeasureSceneBytes(Request.SceneName, Request.StreamingLevel.Get());
+            ResidentCells.Add(Request.SceneName);
+            ResidentBytes.Add(Request.SceneName, CellBytes);
+            CellSizes.Add(Request.SceneName, CellBytes);
+            LastLoadTimings.Add(Request.SceneName, Timings);
+
+            UE_LOG(LogScene, Verbose, TEXT("SceneManagerSubsystem: Streamed in cell %s in %.3fs"),
+                *Request.SceneName.ToString(), Timings.TotalSeconds);
+            BroadcastTimed(ESceneEventType::Loaded, Request.SceneName);
+
+            EnforceResidencyBudget();
+        }
+        else if (Request.Type == ESceneRequestType::Load && Request.bPreload)
+        {
+            PreloadedScenes.Add(Request.SceneName);
+            ResidentBytes.Add(Request.SceneName, MeasureSceneBytes(Request.SceneName, Request.StreamingLevel.Get()));
+            ResidentLRU.Remove(Request.SceneName);
+            ResidentLRU.Add(Request.SceneName);
+
+            UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Preloaded scene %s in %.3fs"),
+                *Request.SceneName.ToString(), Timings.TotalSeconds);
+            BroadcastTimed(ESceneEventType::Preloaded, Request.SceneName);
+
+            EnforceResidencyBudget();
+        }
+        else if (Request.Type == ESceneRequestType::Load)
+        {
+            LastLoadTimings.Add(Request.SceneName, Timings);
+            PreloadedScenes.Remove(Request.SceneName);
+            PredictedScenes.Remove(Request.SceneName);
+            ResidentLRU.Remove(Request.SceneName);
+            if (!ResidentBytes.Contains(Request.SceneName))
+            {
+                ResidentBytes.Add(Request.SceneName, MeasureSceneBytes(Request.SceneName, Request.StreamingLevel.Get()));
+            }
+            CurrentScene = Request.SceneName;
+
+            UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Loaded scene %s in %.3fs (load %.3fs, visible %.3fs)"),
+                *Request.SceneName.ToString(), Timings.TotalSeconds, Timings.FirstPhaseSeconds, Timings.SecondPhaseSeconds);
+            BroadcastTimed(ESceneEventType::Loaded, Request.SceneName);
+
+            UpdatePredictivePreloads(Request.SceneName);
+        }
+        else
+        {
+            LastUnloadTimings.Add(Request.SceneName, Timings);
+            PreloadedScenes.Remove(Request.SceneName);
+            PredictedScenes.Remove(Request.SceneName);
+            ResidentLRU.Remove(Request.SceneName);
+            ResidentBytes.Remove(Request.SceneName);
+            ResidentCells.Remove(Request.SceneName);
+            if (CurrentScene == Request.SceneName) CurrentScene = NAME_None;
+
+            UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Unloaded scene %s in %.3fs (hide %.3fs, unload %.3fs)"),
+                *Request.SceneName.ToString(), Timings.TotalSeconds, Timings.FirstPhaseSeconds, Timings.SecondPhaseSeconds);
+            PublishSceneEvent(ESceneEventType::Unloaded, Request.SceneName);
+        }
+
+        if (Request.Type == ESceneRequestType::Load)
+        {
+            RecordLoadTelemetry(Request, ListenerSeconds);
+        }
+    }
+    else
+    {
+        UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Request %d for scene %s ended as %s"), RequestId, *Request.SceneName.ToString(),
+            FinalState == ESceneRequestState::Cancelled ? TEXT("cancelled") : TEXT("failed"));
+    }
+
+    FSceneRequestHandle Handle;
+    Handle.RequestId = RequestId;
+    OnSceneRequestCompleted.Broadcast(Handle, Request.SceneName, bSuccess);
+
+    OnSwitchRequestFinished(RequestId);
+}
+
+ESceneRequestState USceneManagerSubsystem::GetSceneRequestState(FSceneRequestHandle Handle) const
+{
+    if (const FSceneRequest* Request = ActiveRequests.Find(Handle.RequestId))
+    {
+        return Request->State;
+    }
+
+    if (const ESceneRequestState* State = FinishedRequests.Find(Handle.RequestId))
+    {
+        return *State;
+    }
+
+    return ESceneRequestState::None;
+}
+
+float USceneManagerSubsystem::GetSceneRequestProgress(FSceneRequestHandle Handle) const
+{
+    const FSceneRequest* Request = ActiveRequests.Find(Handle.RequestId);
+    if (!Request)
+    {
+        return GetSceneRequestState(Handle) == ESceneRequestState::Completed ? 1.0f : 0.0f;
+    }
+
+    switch (Request->State)
+    {
+        case ESceneRequestState::Loading:
+            if (const ULevelStreaming* Level = Request->StreamingLevel.Get())
+            {
+                // Package I/O is the bulk of a load, adding the level to the world is the remainder
+                const float Percent = GetAsyncLoadPercentage(Level->GetWorldAssetPackageFName());
+                return Percent >= 0.0f ? 0.9f * Percent / 100.0f : 0.0f;
+            }
+            return 0.0f;
+
+        case ESceneRequestState::MakingVisible:
+            return 0.9f;
+
+        case ESceneRequestState::Hiding:
+            // A hide request is done once the level is no longer visible
+            return 0.5f;
+
+        case ESceneRequestState::Unloading:
+            return Request->FirstPhaseTime > 0.0 ? 0.5f : 0.0f;
+
+        default:
+            return 0.0f;
+    }
+}
+
+bool USceneManagerSubsystem::GetLastSceneTimings(FName SceneName, ESceneRequestType Type, FScenePhaseTimings& OutTimings) const
+{
+    const TMap<FName, FScenePhaseTimings>& Timings = Type == ESceneRequestType::Load ? LastLoadTimings : LastUnloadTimings;
+    if (const FScenePhaseTimings* Found = Timings.Find(SceneName))
+    {
+        OutTimings = *Found;
+        return true;
+    }
+    return false;
+}
+
+void USceneManagerSubsystem::EnsurePolling()
+{
+    if (!PollTickerHandle.IsValid() && !ActiveRequests.IsEmpty())
     {
-        FLatentActionInfo LatentInfo;
-        LatentInfo.CallbackTarget = this;
-        UGameplayStatics::UnloadStreamLevel(this, FName(*Entry->LevelPath.GetAssetName()), LatentInfo, false);
+        PollTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &USceneManagerSubsystem::PollRequests));
+    }
+}
 
-        if (CurrentScene == SceneName) CurrentScene = NAME_None;
-        OnSceneUnloaded.Broadcast(SceneName);
-        UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Unloaded scene %s"), *SceneName.ToString());
+bool USceneManagerSubsystem::PollRequests(float DeltaTime)
+{
+    // Streaming delegates drive completion; this catches transitions that happen without one
+    UpdateRequests();
+
+    if (ActiveRequests.IsEmpty())
+    {
+        PollTickerHandle.Reset();
+        return false;
     }
+    return true;
 }
 
 void USceneManagerSubsystem::SwitchScene(FName SceneName)
 {
-    SceneQueue.Enqueue(SceneName);
+    ++SwitchStats.Requested;
+
+    // Latest wins: a target that has not started yet is simply replaced
+    if (!PendingSwitchTarget.IsNone())
+    {
+        ++SwitchStats.Skipped;
+    }
+    PendingSwitchTarget = SceneName;
+
+    if (!DeferredSwitchTarget.IsNone() && DeferredSwitchTarget != SceneName)
+    {
+        // Waiting on the unload, the deferred load never started
+        ++SwitchStats.Skipped;
+        DeferredSwitchTarget = NAME_None;
+    }
+    else if (PendingSwitchLoad.IsValid() && SwitchLoadScene != SceneName)
+    {
+        AbortSwitchLoad();
+    }
+    else if (PendingSwitchLoad.IsValid() || !DeferredSwitchTarget.IsNone())
+    {
+        // Already heading there
+        PendingSwitchTarget = NAME_None;
+        return;
+    }
+
+    if (!IsSwitchInFlight())
+    {
+        StartNextSwitch();
+    }
+}
+
+bool USceneManagerSubsystem::IsSwitchInFlight() const
+{
+    return PendingSwitchUnload.IsValid() || PendingSwitchLoad.IsValid() || !DeferredSwitchTarget.IsNone();
+}
+
+void USceneManagerSubsystem::AbortSwitchLoad()
+{
+    const FSceneRequestHandle Aborted = PendingSwitchLoad;
+    const FName AbortedScene = SwitchLoadScene;
+    PendingSwitchLoad.Reset();
+    SwitchLoadScene = NAME_None;
+
+    ++SwitchStats.LoadsAborted;
+    UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Aborting switch to %s"), *AbortedScene.ToString());
+
+    // Still streaming the package: drop it. Already resident: keep it around hidden.
+    if (GetSceneRequestState(Aborted) == ESceneRequestState::Loading)
+    {
+        UnloadScene(AbortedScene);
+    }
+    else
+    {
+        RetireScene(AbortedScene);
+    }
+}
+
+void USceneManagerSubsystem::StartNextSwitch()
+{
+    const FName NextScene = PendingSwitchTarget;
+    PendingSwitchTarget = NAME_None;
+
+    if (NextScene.IsNone() || NextScene == CurrentScene)
+    {
+        return;
+    }
+
+    ++SwitchStats.TransitionsStarted;
+
+    // A resident target only needs its visibility flipped, no reason to wait for the unload
+    const bool bInstantSwitch = PreloadedScenes.Contains(NextScene);
+    bInstantSwitch ? ++CacheHits : ++CacheMisses;
 
     if (CurrentScene != NAME_None)
     {
-        OnSceneUnloaded.AddDynamic(this, &USceneManagerSubsystem::OnPreviousSceneUnloaded);
-        UnloadScene(CurrentScene);
+        PendingSwitchUnload = RetireScene(CurrentScene);
+    }
+
+    if (bInstantSwitch || bOverlapSceneSwitch || !PendingSwitchUnload.IsValid())
+    {
+        SwitchLoadScene = NextScene;
+        PendingSwitchLoad = LoadScene(NextScene);
+        if (bInstantSwitch)
+        {
+            FlushVisibility();
+        }
+    }
+    else
+    {
+        DeferredSwitchTarget = NextScene;
+    }
+
+    // Nothing could be started, fall through to whatever was requested meanwhile
+    if (!IsSwitchInFlight() && !PendingSwitchTarget.IsNone())
+    {
+        StartNextSwitch();
+    }
+}
+
+void USceneManagerSubsystem::OnSwitchRequestFinished(int32 RequestId)
+{
+    if (PendingSwitchUnload.RequestId == RequestId)
+    {
+        PendingSwitchUnload.Reset();
+        if (!DeferredSwitchTarget.IsNone())
+        {
+            SwitchLoadScene = DeferredSwitchTarget;
+            DeferredSwitchTarget = NAME_None;
+            PendingSwitchLoad = LoadScene(SwitchLoadScene);
+        }
+    }
+    else if (PendingSwitchLoad.RequestId == RequestId)
+    {
+        PendingSwitchLoad.Reset();
+        SwitchLoadScene = NAME_None;
+    }
+    else
+    {
+        return;
+    }
+
+    if (!IsSwitchInFlight())
+    {
+        StartNextSwitch();
+    }
+}
+
+void USceneManagerSubsystem::FlushVisibility()
+{
+    // Packages are already resident, so this is only the add/remove-from-world work
+    if (UWorld* World = GetWorld())
+    {
+        World->FlushLevelStreaming(EFlushLevelStreamingType::Visibility);
+    }
+    UpdateRequests();
+}
+
+void USceneManagerSubsystem::UpdatePredictivePreloads(FName NewCurrentScene)
+{
+    const FSceneEntry* Entry = FindSceneEntry(NewCurrentScene);
+    if (!bPredictivePreload || !Entry)
+    {
+        return;
+    }
+
+    // Predictions that are no longer one step away stay in the residency cache until evicted
+    for (const FName Predicted : PredictedScenes.Array())
+    {
+        if (!Entry->AdjacentScenes.Contains(Predicted))
+        {
+            PredictedScenes.Remove(Predicted);
+        }
+    }
+
+    int32 Preloads = PredictedScenes.Num();
+    for (const FName Adjacent : Entry->AdjacentScenes)
+    {
+        if (Preloads >= MaxPredictivePreloads)
+        {
+            break;
+        }
+
+        if (Adjacent == NewCurrentScene || PredictedScenes.Contains(Adjacent) || PreloadedScenes.Contains(Adjacent))
+        {
+            continue;
+        }
+
+        if (PreloadScene(Adjacent).IsValid())
+        {
+            PredictedScenes.Add(Adjacent);
+            ++Preloads;
+        }
+    }
+}
+
+FSceneRequestHandle USceneManagerSubsystem::RetireScene(FName SceneName)
+{
+    if (ResidencyBudgetMB > 0)
+    {
+        return StartRequest(SceneName, ESceneRequestType::Hide, false);
+    }
+    return UnloadScene(SceneName);
+}
+
+bool USceneManagerSubsystem::HasActiveRequest(FName SceneName) const
+{
+    for (const auto& Pair : ActiveRequests)
+    {
+        if (Pair.Value.SceneName == SceneName)
+        {
+            return true;
+        }
     }
-    else ProcessNextSceneInQueue();
+    return false;
+}
+
+bool USceneManagerSubsystem::HasActiveUnload(FName SceneName) const
+{
+    for (const auto& Pair : ActiveRequests)
+    {
+        if (Pair.Value.SceneName == SceneName && Pair.Value.Type == ESceneRequestType::Unload)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int64 USceneManagerSubsystem::MeasureSceneBytes(FName SceneName, const ULevelStreaming* Level) const
+{
+    if (const FSceneEntry* Entry = FindSceneEntry(SceneName))
+    {
+        if (Entry->EstimatedMemoryMB > 0.0f)
+        {
+            return static_cast<int64>(Entry->EstimatedMemoryMB * 1024.0 * 1024.0);
+        }
+    }
+
+    const ULevel* LoadedLevel = Level ? Level->GetLoadedLevel() : nullptr;
+    if (!LoadedLevel)
+    {
+        return 0;
+    }
+
+    int64 Bytes = 0;
+    for (const AActor* Actor : LoadedLevel->Actors)
+    {
+        if (!Actor)
+        {
+            continue;
+        }
+
+        Bytes += Actor->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+        for (const UActorComponent* Component : Actor->GetComponents())
+        {
+            if (Component)
+            {
+                Bytes += Component->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+            }
+        }
+    }
+    return Bytes;
+}
+
+void USceneManagerSubsystem::PinScene(FName SceneName, bool bPinned)
+{
+    if (bPinned)
+    {
+        PinnedScenes.Add(SceneName);
+    }
+    else
+    {
+        PinnedScenes.Remove(SceneName);
+        EnforceResidencyBudget();
+    }
+}
+
+void USceneManagerSubsystem::EvictScene(FName SceneName)
+{
+    ResidentLRU.Remove(SceneName);
+    PreloadedScenes.Remove(SceneName);
+    PredictedScenes.Remove(SceneName);
+    ResidentBytes.Remove(SceneName);
+    ++CacheEvictions;
+
+    UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Evicting cached scene %s"), *SceneName.ToString());
+    UnloadScene(SceneName);
+}
+
+void USceneManagerSubsystem::EnforceResidencyBudget()
+{
+    const uint64 AvailablePhysical = FPlatformMemory::GetStats().AvailablePhysical;
+    if (AvailablePhysical < static_cast<uint64>(MinFreePhysicalMB) * 1024 * 1024)
+    {
+        UE_LOG(LogScene, Warning, TEXT("SceneManagerSubsystem: Low memory (%llu MB free), shedding cached scenes"),
+            AvailablePhysical / (1024 * 1024));
+        ShedCachedScenes();
+        return;
+    }
+
+    // Cells have their own budget, enforced by UpdateSpatialStreaming
+    const int64 Budget = static_cast<int64>(ResidencyBudgetMB) * 1024 * 1024;
+    int64 Total = 0;
+    for (const auto& Pair : ResidentBytes)
+    {
+        if (!ResidentCells.Contains(Pair.Key))
+        {
+            Total += Pair.Value;
+        }
+    }
+
+    // Oldest first; pinned and in-flight scenes are skipped
+    for (int32 Index = 0; Index < ResidentLRU.Num() && Total > Budget;)
+    {
+        const FName Candidate = ResidentLRU[Index];
+        if (PinnedScenes.Contains(Candidate) || HasActiveRequest(Candidate))
+        {
+            ++Index;
+            continue;
+        }
+
+        Total -= ResidentBytes.FindRef(Candidate);
+        EvictScene(Candidate);
+    }
+}
+
+void USceneManagerSubsystem::ShedCachedScenes()
+{
+    for (const FName Cached : TArray<FName>(ResidentLRU))
+    {
+        if (!PinnedScenes.Contains(Cached) && !HasActiveRequest(Cached))
+        {
+            EvictScene(Cached);
+        }
+    }
+}
+
+void USceneManagerSubsystem::HandleMemoryTrim()
+{
+    UE_LOG(LogScene, Warning, TEXT("SceneManagerSubsystem: Memory trim requested, shedding cached scenes"));
+    ShedCachedScenes();
+}
+
+static void RunSceneSwitchStress(const TArray<FString>& Args, UWorld* World)
+{
+    UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    USceneManagerSubsystem* SceneManager = GameInstance ? GameInstance->GetSubsystem<USceneManagerSubsystem>() : nullptr;
+    if (!SceneManager)
+    {
+        return;
+    }
+
+    const int32 NumSwitches = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 50;
+    const float Interval = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 0.0f) : 0.05f;
+
+    TArray<FName> Scenes = SceneManager->GetRegisteredSceneNames();
+    if (Scenes.IsEmpty())
+    {
+        UE_LOG(LogScene, Warning, TEXT("Scene switch stress: no registered scenes"));
+        return;
+    }
+
+    const FSceneSwitchStats Before = SceneManager->GetSwitchStats();
+    TWeakObjectPtr<USceneManagerSubsystem> WeakManager = SceneManager;
+    int32 Fired = 0;
+
+    UE_LOG(LogScene, Log, TEXT("Scene switch stress: %d switches every %.3fs across %d scenes"), NumSwitches, Interval, Scenes.Num());
+
+    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakManager, Scenes, NumSwitches, Before, Fired](float) mutable
+    {
+        USceneManagerSubsystem* Manager = WeakManager.Get();
+        if (!Manager)
+        {
+            return false;
+        }
+
+        if (Fired < NumSwitches)
+        {
+            Manager->SwitchScene(Scenes[Fired % Scenes.Num()]);
+            ++Fired;
+            return true;
+        }
+
+        const FSceneSwitchStats After = Manager->GetSwitchStats();
+        UE_LOG(LogScene, Log, TEXT("Scene switch stress: %d requested, %d transitions started, %d skipped, %d loads aborted"),
+            After.Requested - Before.Requested, After.TransitionsStarted - Before.TransitionsStarted,
+            After.Skipped - Before.Skipped, After.LoadsAborted - Before.LoadsAborted);
+        return false;
+    }), Interval);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs SceneSwitchStressCommand(
+    TEXT("Twin.Scene.SwitchStress"),
+    TEXT("Fires rapid SwitchScene calls across the registered scenes and reports how much work was done. Usage: Twin.Scene.SwitchStress [Count] [IntervalSeconds]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunSceneSwitchStress));
+
+TArray<FName> USceneManagerSubsystem::GetRegisteredSceneNames() const
+{
+    TArray<FName> Names;
+    if (SceneRegistry)
+    {
+        for (const FSceneEntry& Entry : SceneRegistry->Scenes)
+        {
+            Names.Add(Entry.SceneName);
+        }
+    }
+    return Names;
+}
+
+FSceneResidencyStats USceneManagerSubsystem::GetResidencyStats() const
+{
+    FSceneResidencyStats Stats;
+    Stats.Hits = CacheHits;
+    Stats.Misses = CacheMisses;
+    Stats.HitRate = CacheHits + CacheMisses > 0 ? static_cast<float>(CacheHits) / static_cast<float>(CacheHits + CacheMisses) : 0.0f;
+    Stats.Evictions = CacheEvictions;
+    Stats.ResidentScenes = ResidentBytes.Num();
+    Stats.CachedScenes = ResidentLRU.Num();
+    for (const auto& Pair : ResidentBytes)
+    {
+        Stats.ResidentBytes += Pair.Value;
+    }
+    return Stats;
+}
+
+void USceneManagerSubsystem::SetSpatialStreamingEnabled(bool bEnabled)
+{
+    if (bEnabled && !SpatialTickerHandle.IsValid())
+    {
+        SpatialTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &USceneManagerSubsystem::UpdateSpatialStreaming), SpatialUpdateInterval);
+        UnavailableCells.Reset();
+        UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Spatial streaming enabled"));
+    }
+    else if (!bEnabled && SpatialTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SpatialTickerHandle);
+        SpatialTickerHandle.Reset();
+        UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Spatial streaming disabled"));
+    }
+}
+
+bool USceneManagerSubsystem::GetStreamingViewPoint(FVector& OutLocation, FVector& OutForward, FVector& OutVelocity) const
+{
+    APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
+    if (!PC)
+    {
+        return false;
+    }
+
+    FRotator ViewRotation;
+    PC->GetPlayerViewPoint(OutLocation, ViewRotation);
+    OutForward = ViewRotation.Vector();
+    OutVelocity = PC->GetPawn() ? PC->GetPawn()->GetVelocity() : FVector::ZeroVector;
+    return true;
+}
+
+bool USceneManagerSubsystem::UpdateSpatialStreaming(float DeltaTime)
+{
+    FVector Location;
+    FVector Forward;
+    FVector Velocity;
+    if (!SceneRegistry || !GetStreamingViewPoint(Location, Forward, Velocity))
+    {
+        return true;
+    }
+
+    const FVector Predicted = Location + Velocity * VelocityLookaheadSeconds;
+    const float UnloadRadius = FMath::Max(CellUnloadRadius, CellLoadRadius);
+
+    struct FCellCandidate
+    {
+        FName SceneName;
+        float Distance = 0.0f;
+        float Priority = 0.0f;
+    };
+    TArray<FCellCandidate> Wanted;
+    TArray<FName> ToUnload;
+
+    for (const FSceneEntry& Entry : SceneRegistry->Scenes)
+    {
+        if (!Entry.bSpatialCell || !Entry.Bounds.IsValid || UnavailableCells.Contains(Entry.SceneName))
+        {
+            continue;
+        }
+
+        // Closest of where the camera is and where it is heading
+        const float Distance = FMath::Sqrt(FMath::Min(
+            Entry.Bounds.ComputeSquaredDistanceToPoint(Location),
+            Entry.Bounds.ComputeSquaredDistanceToPoint(Predicted)));
+
+        const bool bResident = ResidentCells.Contains(Entry.SceneName) || CellLoads.Contains(Entry.SceneName);
+        if (Distance <= CellLoadRadius || (bResident && Distance <= UnloadRadius))
+        {
+            const FVector ToCell = (Entry.Bounds.GetCenter() - Location).GetSafeNormal();
+            const float Facing = ToCell.IsNearlyZero() ? 1.0f : FVector::DotProduct(Forward, ToCell);
+
+            FCellCandidate& Candidate = Wanted.AddDefaulted_GetRef();
+            Candidate.SceneName = Entry.SceneName;
+            Candidate.Distance = Distance;
+            Candidate.Priority = Distance * (1.0f - ViewDirectionWeight * 0.5f * (Facing + 1.0f));
+        }
+        else if (bResident)
+        {
+            ToUnload.Add(Entry.SceneName);
+        }
+    }
+
+    // Front-of-camera and near cells first; anything past the cap or the cell budget is treated as out of range
+    Wanted.Sort([](const FCellCandidate& A, const FCellCandidate& B) { return A.Priority < B.Priority; });
+    int32 NumKept = FMath::Min(Wanted.Num(), MaxResidentCells);
+    if (CellBudgetMB > 0)
+    {
+        const int64 CellBudget = static_cast<int64>(CellBudgetMB) * 1024 * 1024;
+        int64 CellBytes = 0;
+        for (int32 Index = 0; Index < NumKept; ++Index)
+        {
+            const FName Cell = Wanted[Index].SceneName;
+            const int64* Measured = CellSizes.Find(Cell);
+            CellBytes += Measured ? *Measured : MeasureSceneBytes(Cell, nullptr);
+
+            // The nearest cell is always kept, even on its own above the budget
+            if (CellBytes > CellBudget && Index > 0)
+            {
+                NumKept = Index;
+                break;
+            }
+        }
+    }
+
+    for (int32 Index = NumKept; Index < Wanted.Num(); ++Index)
+    {
+        if (ResidentCells.Contains(Wanted[Index].SceneName) || CellLoads.Contains(Wanted[Index].SceneName))
+        {
+            ToUnload.Add(Wanted[Index].SceneName);
+        }
+    }
+    Wanted.SetNum(NumKept);
+
+    for (const FName Cell : ToUnload)
+    {
+        // A cell stays resident until its unload finishes; requesting it again would restart the unload and its snapshot
+        CellLoads.Remove(Cell);
+        if (!HasActiveUnload(Cell))
+        {
+            UnloadScene(Cell);
+        }
+    }
+
+    for (const FCellCandidate& Candidate : Wanted)
+    {
+        if (CellLoads.Num() >= MaxConcurrentCellLoads)
+        {
+            break;
+        }
+
+        if (ResidentCells.Contains(Candidate.SceneName) || CellLoads.Contains(Candidate.SceneName))
+        {
+            continue;
+        }
+
+        const FSceneRequestHandle Handle = StartRequest(Candidate.SceneName, ESceneRequestType::Load, true, false, true);
+        if (!Handle.IsValid())
+        {
+            // Not a streaming level of this world, don't retry every update
+            UnavailableCells.Add(Candidate.SceneName);
+        }
+        else if (GetSceneRequestState(Handle) != ESceneRequestState::Completed)
+        {
+            CellLoads.Add(Candidate.SceneName, Handle);
+        }
+    }
+
+    return true;
+}
+
+void USceneManagerSubsystem::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+    if (!Level || World != GetWorld())
+    {
+        return;
+    }
+
+    if (World == IndexedWorld.Get())
+    {
+        const FName SceneName = FindSceneForLevel(Level);
+        const int32 Added = ActorIndex.AddLevel(Level, SceneName);
+        if (Added > 0)
+        {
+            PublishActorIndexChanged(SceneName, Added, 0);
+        }
+    }
+
+    for (auto& Pair : ActiveRequests)
+    {
+        FSceneRequest& Request = Pair.Value;
+        const ULevelStreaming* StreamingLevel = Request.StreamingLevel.Get();
+        if (Request.Type == ESceneRequestType::Load && StreamingLevel && StreamingLevel->GetLoadedLevel() == Level)
+        {
+            Request.LevelAddedTime = FPlatformTime::Seconds();
+            TRACE_BOOKMARK(TEXT("Scene level added: %s"), *Request.SceneName.ToString());
+        }
+    }
+}
+
+void USceneManagerSubsystem::RecordLoadTelemetry(const FSceneRequest& Request, double ListenerSeconds)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    FSceneLoadTelemetry Entry;
+    Entry.SceneName = Request.SceneName;
+    Entry.RequestId = Request.Id;
+    Entry.RequestedAt = static_cast<float>(Request.RequestedTime - TelemetryStartTime);
+    Entry.PackageLoadedSeconds = static_cast<float>(Request.FirstPhaseTime - Request.RequestedTime);
+    // Stays 0 for preloads and for levels that were already in the world
+    Entry.LevelAddedSeconds = Request.LevelAddedTime > 0.0 ? static_cast<float>(Request.LevelAddedTime - Request.RequestedTime) : 0.0f;
+    Entry.VisibleSeconds = Request.bMakeVisible ? static_cast<float>(Request.CompletedTime - Request.RequestedTime) : 0.0f;
+    Entry.ListenersDoneSeconds = static_cast<float>(Now - Request.RequestedTime);
+    Entry.ListenerSeconds = static_cast<float>(ListenerSeconds);
+    Entry.ResidentBytes = ResidentBytes.FindRef(Request.SceneName);
+    Entry.bPreload = Request.bPreload;
+    Entry.PackageBytes = PackageSizes.FindRef(Request.SceneName);
+
+    const ULevelStreaming* StreamingLevel = Request.StreamingLevel.Get();
+    if (const ULevel* LoadedLevel = StreamingLevel ? StreamingLevel->GetLoadedLevel() : nullptr)
+    {
+        for (const AActor* Actor : LoadedLevel->Actors)
+        {
+            Entry.ActorCount += Actor ? 1 : 0;
+        }
+    }
+
+    TRACE_BOOKMARK(TEXT("Scene load done: %s"), *Request.SceneName.ToString());
+
+    if (SceneTimeline.Num() >= SceneManager::MaxTimelineEntries)
+    {
+        SceneTimeline.RemoveAt(0, SceneTimeline.Num() - SceneManager::MaxTimelineEntries + 1, EAllowShrinking::No);
+    }
+    SceneTimeline.Add(MoveTemp(Entry));
+}
+
+void USceneManagerSubsystem::ResolvePackageSize(FName SceneName, const FSceneEntry& Entry)
+{
+    if (PackageSizes.Contains(SceneName))
+    {
+        return;
+    }
+    PackageSizes.Add(SceneName, 0);
+
+    // Package lookup and file size are disk I/O, kept off the game thread
+    TWeakObjectPtr<USceneManagerSubsystem> WeakThis(this);
+    Async(EAsyncExecution::ThreadPool, [WeakThis, SceneName, PackageName = Entry.LevelPath.GetLongPackageName()]()
+    {
+        int64 Bytes = 0;
+        FString Filename;
+        if (FPackageName::DoesPackageExist(PackageName, &Filename))
+        {
+            Bytes = FMath::Max<int64>(IFileManager::Get().FileSize(*Filename), 0);
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, SceneName, Bytes]()
+        {
+            USceneManagerSubsystem* This = WeakThis.Get();
+            if (!This)
+            {
+                return;
+            }
+
+            This->PackageSizes.Add(SceneName, Bytes);
+
+            // Loads that finished before the size was known
+            for (FSceneLoadTelemetry& TimelineEntry : This->SceneTimeline)
+            {
+                if (TimelineEntry.SceneName == SceneName && TimelineEntry.PackageBytes == 0)
+                {
+                    TimelineEntry.PackageBytes = Bytes;
+                }
+            }
+        });
+    });
+}
+
+bool USceneManagerSubsystem::ExportSceneTimelineCSV(const FString& FilePath) const
+{
+    FString Csv = TEXT("RequestId,Scene,Preload,RequestedAt,PackageLoaded,LevelAdded,Visible,ListenersDone,ListenerSeconds,PackageBytes,ResidentBytes,Actors\n");
+    for (const FSceneLoadTelemetry& Entry : SceneTimeline)
+    {
+        Csv += FString::Printf(TEXT("%d,%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%lld,%lld,%d\n"),
+            Entry.RequestId, *Entry.SceneName.ToString(), Entry.bPreload ? 1 : 0, Entry.RequestedAt,
+            Entry.PackageLoadedSeconds, Entry.LevelAddedSeconds, Entry.VisibleSeconds, Entry.ListenersDoneSeconds,
+            Entry.ListenerSeconds, Entry.PackageBytes, Entry.ResidentBytes, Entry.ActorCount);
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+    {
+        UE_LOG(LogScene, Error, TEXT("SceneManagerSubsystem: Failed to write scene timeline to %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Wrote %d scene loads to %s"), SceneTimeline.Num(), *FilePath);
+    return true;
+}
+
+static void DumpSceneTimeline(const TArray<FString>& Args, UWorld* World)
+{
+    UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    USceneManagerSubsystem* SceneManager = GameInstance ? GameInstance->GetSubsystem<USceneManagerSubsystem>() : nullptr;
+    if (!SceneManager)
+    {
+        return;
+    }
+
+    const FString FilePath = Args.Num() > 0
+        ? Args[0]
+        : FPaths::Combine(FPaths::ProfilingDir(), TEXT("SceneTimeline"), FString::Printf(TEXT("SceneTimeline-%s.csv"), *FDateTime::Now().ToString()));
+    SceneManager->ExportSceneTimelineCSV(FilePath);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs DumpSceneTimelineCommand(
+    TEXT("Twin.Scene.DumpTimeline"),
+    TEXT("Writes the per-scene load timeline (phase timings, bytes, actor counts) as CSV. Usage: Twin.Scene.DumpTimeline [FilePath]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&DumpSceneTimeline));
+
+bool USceneManagerSubsystem::CaptureSceneState(FName SceneName)
+{
+    const FSceneEntry* Entry = FindSceneEntry(SceneName);
+    ULevelStreaming* StreamingLevel = Entry ? FindStreamingLevel(*Entry) : nullptr;
+    ULevel* Level = StreamingLevel ? StreamingLevel->GetLoadedLevel() : nullptr;
+    if (!Level)
+    {
+        UE_LOG(LogScene, Warning, TEXT("SceneManagerSubsystem: Cannot snapshot scene %s, it is not loaded"), *SceneName.ToString());
+        return false;
+    }
+
+    // A newer capture replaces one that is still running
+    SnapshotCaptures.Add(SceneName, BeginSnapshotCapture(Level));
+    if (!SnapshotTickerHandle.IsValid())
+    {
+        SnapshotTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &USceneManagerSubsystem::TickSnapshotCaptures));
+    }
+    return true;
+}
+
+void USceneManagerSubsystem::ReleaseSnapshotUnload(FName SceneName)
+{
+    for (auto& Pair : ActiveRequests)
+    {
+        FSceneRequest& Request = Pair.Value;
+        if (Request.SceneName == SceneName && Request.bAwaitingSnapshot)
+        {
+            Request.bAwaitingSnapshot = false;
+            if (ULevelStreaming* Level = Request.StreamingLevel.Get())
+            {
+                Level->SetShouldBeLoaded(false);
+            }
+        }
+    }
+}
+
+TSharedPtr<USceneManagerSubsystem::FSnapshotCapture> USceneManagerSubsystem::BeginSnapshotCapture(ULevel* Level) const
+{
+    TArray<UObject*> Objects;
+    TwinSceneState::GatherObjects(Level, Objects);
+
+    TSharedPtr<FSnapshotCapture> Capture = MakeShared<FSnapshotCapture>();
+    Capture->Level = Level;
+    Capture->Objects.Reserve(Objects.Num());
+    for (UObject* Object : Objects)
+    {
+        Capture->Objects.Add(Object);
+    }
+    return Capture;
+}
+
+bool USceneManagerSubsystem::StepSnapshotCapture(FSnapshotCapture& Capture, double Deadline) const
+{
+    FMemoryWriter Writer(Capture.RawData);
+    Writer.Seek(Capture.RawData.Num());
+
+    while (Capture.NextObject < Capture.Objects.Num())
+    {
+        // Objects destroyed since the capture started are left out
+        if (UObject* Object = Capture.Objects[Capture.NextObject].Get())
+        {
+            Capture.NumProperties += TwinSceneState::WriteObject(Writer, Object);
+            ++Capture.NumObjects;
+        }
+        ++Capture.NextObject;
+
+        if ((Capture.NextObject & 15) == 0 && FPlatformTime::Seconds() > Deadline)
+        {
+            break;
+        }
+    }
+    return Capture.NextObject >= Capture.Objects.Num();
+}
+
+void USceneManagerSubsystem::FinishSnapshotCapture(FName SceneName, FSnapshotCapture& Capture)
+{
+    DiscardSceneSnapshot(SceneName);
+    if (Capture.NumObjects == 0)
+    {
+        // Nothing in the scene carries SaveGame state
+        return;
+    }
+
+    TSharedPtr<FSceneStateSnapshot> Snapshot = MakeShared<FSceneStateSnapshot>();
+    Snapshot->SceneName = SceneName;
+    Snapshot->CaptureTime = FPlatformTime::Seconds();
+    Snapshot->NumObjects = Capture.NumObjects;
+    Snapshot->NumProperties = Capture.NumProperties;
+    Snapshot->RawSize = Capture.RawData.Num();
+    Snapshot->RawData = MoveTemp(Capture.RawData);
+    Snapshots.Add(SceneName, Snapshot);
+
+    UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Captured scene %s state, %d objects, %d properties (%.1f KB)"),
+        *SceneName.ToString(), Snapshot->NumObjects, Snapshot->NumProperties, Snapshot->RawSize / 1024.0);
+    PublishSceneEvent(ESceneEventType::StateCaptured, SceneName);
+
+    // The raw stream stays usable for restores until compression is done; only the game thread mutates the snapshot
+    TWeakObjectPtr<USceneManagerSubsystem> WeakThis(this);
+    Async(EAsyncExecution::ThreadPool, [WeakThis, Snapshot]()
+    {
+        TArray<uint8> Compressed;
+        if (!TwinSceneState::Compress(Snapshot->RawData, Compressed))
+        {
+            return;
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Snapshot, Compressed = MoveTemp(Compressed)]() mutable
+        {
+            USceneManagerSubsystem* This = WeakThis.Get();
+            if (!This || This->Snapshots.FindRef(Snapshot->SceneName) != Snapshot)
+            {
+                return;
+            }
+
+            Snapshot->CompressedData = MoveTemp(Compressed);
+            Snapshot->RawData.Empty();
+            This->EnforceSnapshotBudget();
+        });
+    });
+}
+
+bool USceneManagerSubsystem::TickSnapshotCaptures(float DeltaTime)
+{
+    const double Deadline = FPlatformTime::Seconds() + SnapshotTimeSliceMs / 1000.0;
+
+    TArray<FName> Finished;
+    for (auto& Pair : SnapshotCaptures)
+    {
+        if (!Pair.Value->Level.IsValid() || StepSnapshotCapture(*Pair.Value, Deadline))
+        {
+            Finished.Add(Pair.Key);
+        }
+        if (FPlatformTime::Seconds() > Deadline)
+        {
+            break;
+        }
+    }
+
+    for (const FName SceneName : Finished)
+    {
+        TSharedPtr<FSnapshotCapture> Capture;
+        SnapshotCaptures.RemoveAndCopyValue(SceneName, Capture);
+        if (Capture->Level.IsValid())
+        {
+            FinishSnapshotCapture(SceneName, *Capture);
+        }
+        ReleaseSnapshotUnload(SceneName);
+    }
+
+    if (SnapshotCaptures.IsEmpty())
+    {
+        SnapshotTickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void USceneManagerSubsystem::PrefetchSnapshot(FName SceneName)
+{
+    const TSharedPtr<FSceneStateSnapshot> Snapshot = Snapshots.FindRef(SceneName);
+    if (!Snapshot || !Snapshot->RawData.IsEmpty() || SnapshotPrefetches.Contains(SceneName))
+    {
+        return;
+    }
+
+    SnapshotPrefetches.Add(SceneName, Async(EAsyncExecution::ThreadPool,
+        [Compressed = Snapshot->CompressedData, SpillPath = Snapshot->SpillPath, RawSize = Snapshot->RawSize]() mutable -> TArray<uint8>
+        {
+            TArray<uint8> RawData;
+            if (Compressed.IsEmpty() && !FFileHelper::LoadFileToArray(Compressed, *SpillPath))
+            {
+                return RawData;
+            }
+            TwinSceneState::Decompress(Compressed, RawSize, RawData);
+            return RawData;
+        }));
+}
+
+bool USceneManagerSubsystem::RestoreSceneState(FName SceneName)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(USceneManagerSubsystem::RestoreSceneState);
+
+    const TSharedPtr<FSceneStateSnapshot> Snapshot = Snapshots.FindRef(SceneName);
+    const FSceneEntry* Entry = FindSceneEntry(SceneName);
+    ULevelStreaming* StreamingLevel = Entry ? FindStreamingLevel(*Entry) : nullptr;
+    ULevel* Level = StreamingLevel ? StreamingLevel->GetLoadedLevel() : nullptr;
+    if (!Snapshot || !Level)
+    {
+        return false;
+    }
+
+    TArray<uint8> Decompressed;
+    const TArray<uint8>* RawData = &Snapshot->RawData;
+    if (RawData->IsEmpty())
+    {
+        PrefetchSnapshot(SceneName);
+        if (TFuture<TArray<uint8>>* Prefetch = SnapshotPrefetches.Find(SceneName))
+        {
+            // Usually finished already, the level took longer to stream than the snapshot to read
+            Decompressed = Prefetch->Get();
+            SnapshotPrefetches.Remove(SceneName);
+        }
+        RawData = &Decompressed;
+    }
+
+    if (RawData->IsEmpty())
+    {
+        UE_LOG(LogScene, Error, TEXT("SceneManagerSubsystem: Could not read the state snapshot of scene %s"), *SceneName.ToString());
+        return false;
+    }
+
+    const FSceneStateRestoreStats Stats = TwinSceneState::Restore(Level, *RawData);
+    UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Restored scene %s state in %.2fms (%d objects, %d properties applied, %d unchanged, %d actors respawned, %d missing)"),
+        *SceneName.ToString(), Stats.Seconds * 1000.0, Stats.ObjectsRestored, Stats.PropertiesApplied, Stats.PropertiesUnchanged,
+        Stats.ActorsRespawned, Stats.ObjectsMissing);
+    PublishSceneEvent(ESceneEventType::StateRestored, SceneName);
+    return true;
+}
+
+void USceneManagerSubsystem::DiscardSceneSnapshot(FName SceneName)
+{
+    SnapshotPrefetches.Remove(SceneName);
+
+    TSharedPtr<FSceneStateSnapshot> Snapshot;
+    if (Snapshots.RemoveAndCopyValue(SceneName, Snapshot) && !Snapshot->SpillPath.IsEmpty())
+    {
+        IFileManager::Get().Delete(*Snapshot->SpillPath, false, false, true);
+    }
+}
+
+void USceneManagerSubsystem::EnforceSnapshotBudget()
+{
+    if (!bSpillSnapshotsToDisk)
+    {
+        return;
+    }
+
+    const int64 Budget = static_cast<int64>(SnapshotMemoryBudgetMB) * 1024 * 1024;
+    int64 Total = 0;
+    TArray<TSharedPtr<FSceneStateSnapshot>> Candidates;
+    for (const auto& Pair : Snapshots)
+    {
+        Total += Pair.Value->GetMemoryBytes();
+        if (Pair.Value->RawData.IsEmpty() && !Pair.Value->CompressedData.IsEmpty())
+        {
+            Candidates.Add(Pair.Value);
+        }
+    }
+
+    if (Total <= Budget)
+    {
+        return;
+    }
+
+    // Oldest first
+    Candidates.Sort([](const TSharedPtr<FSceneStateSnapshot>& A, const TSharedPtr<FSceneStateSnapshot>& B)
+    {
+        return A->CaptureTime < B->CaptureTime;
+    });
+
+    TWeakObjectPtr<USceneManagerSubsystem> WeakThis(this);
+    for (const TSharedPtr<FSceneStateSnapshot>& Snapshot : Candidates)
+    {
+        if (Total <= Budget)
+        {
+            break;
+        }
+        Total -= Snapshot->GetMemoryBytes();
+
+        const FString SpillPath = FPaths::Combine(SnapshotSpillDir,
+            FString::Printf(TEXT("%s-%s.twsnap"), *Snapshot->SceneName.ToString(), *FGuid::NewGuid().ToString()));
+
+        // Data stays in memory until the file is on disk so restores never see a half-written spill
+        Async(EAsyncExecution::ThreadPool, [WeakThis, Snapshot, SpillPath, Data = Snapshot->CompressedData]()
+        {
+            const bool bWritten = FFileHelper::SaveArrayToFile(Data, *SpillPath);
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Snapshot, SpillPath, bWritten]()
+            {
+                USceneManagerSubsystem* This = WeakThis.Get();
+                if (!bWritten)
+                {
+                    UE_LOG(LogScene, Error, TEXT("SceneManagerSubsystem: Failed to spill scene %s snapshot to %s"), *Snapshot->SceneName.ToString(), *SpillPath);
+                    return;
+                }
+
+                // Discarded meanwhile, or an earlier spill of the same snapshot already landed
+                if (!This || This->Snapshots.FindRef(Snapshot->SceneName) != Snapshot || !Snapshot->SpillPath.IsEmpty())
+                {
+                    IFileManager::Get().Delete(*SpillPath, false, false, true);
+                    return;
+                }
+
+                Snapshot->SpillPath = SpillPath;
+                Snapshot->CompressedData.Empty();
+                UE_LOG(LogScene, Verbose, TEXT("SceneManagerSubsystem: Spilled scene %s snapshot to disk"), *Snapshot->SceneName.ToString());
+            });
+        });
+    }
+}
+
+FName USceneManagerSubsystem::FindSceneForLevel(const ULevel* Level) const
+{
+    if (!SceneRegistry || !Level)
+    {
+        return NAME_None;
+    }
+
+    // PIE duplicates streamed packages under a UEDPIE_ prefix
+    const FString PackageName = UWorld::RemovePIEPrefix(Level->GetOutermost()->GetName());
+    const FSceneEntry* Entry = SceneRegistry->FindSceneByLevel(FName(*PackageName));
+    return Entry ? Entry->SceneName : NAME_None;
+}
+
+void USceneManagerSubsystem::HandleWorldActorsInitialized(const FActorsInitializedParams& Params)
+{
+    if (Params.World && Params.World == GetWorld())
+    {
+        BindActorIndex(Params.World);
+    }
+}
+
+void USceneManagerSubsystem::BindActorIndex(UWorld* World)
+{
+    UnbindActorIndex();
+
+    IndexedWorld = World;
+    ActorIndex.SetMetadataKey(ActorMetadataKey);
+    ActorIndex.AddLevel(World->PersistentLevel, NAME_None);
+    for (const ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+    {
+        ULevel* Level = StreamingLevel ? StreamingLevel->GetLoadedLevel() : nullptr;
+        if (Level && Level->bIsVisible)
+        {
+            ActorIndex.AddLevel(Level, FindSceneForLevel(Level));
+        }
+    }
+
+    ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(this, &USceneManagerSubsystem::HandleActorSpawned));
+    ActorDestroyedHandle = World->AddOnActorDestroyedHandler(
+        FOnActorDestroyed::FDelegate::CreateUObject(this, &USceneManagerSubsystem::HandleActorDestroyed));
+
+    const FSceneActorIndexStats Stats = ActorIndex.GetStats();
+    UE_LOG(LogScene, Log, TEXT("SceneManagerSubsystem: Indexed %d actors in %d levels (%.1f KB)"),
+        Stats.IndexedActors, Stats.IndexedLevels, Stats.MemoryBytes / 1024.0);
+}
+
+void USceneManagerSubsystem::UnbindActorIndex()
+{
+    if (UWorld* World = IndexedWorld.Get())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+    ActorSpawnedHandle.Reset();
+    ActorDestroyedHandle.Reset();
+    IndexedWorld.Reset();
+    ActorIndex.Reset();
+}
+
+void USceneManagerSubsystem::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+    if (!World || World != IndexedWorld.Get())
+    {
+        return;
+    }
+
+    // A null level means the whole world is going away
+    if (!Level)
+    {
+        UnbindActorIndex();
+        return;
+    }
+
+    const FName SceneName = ActorIndex.GetSceneForLevel(Level);
+    const int32 Removed = ActorIndex.RemoveLevel(Level);
+    if (Removed > 0)
+    {
+        PublishActorIndexChanged(SceneName, 0, Removed);
+    }
+}
+
+void USceneManagerSubsystem::HandleActorSpawned(AActor* Actor)
+{
+    if (ActorIndex.AddActor(Actor))
+    {
+        PublishActorIndexChanged(ActorIndex.GetSceneForLevel(Actor->GetLevel()), 1, 0);
+    }
+}
+
+void USceneManagerSubsystem::HandleActorDestroyed(AActor* Actor)
+{
+    if (ActorIndex.RemoveActor(Actor))
+    {
+        PublishActorIndexChanged(ActorIndex.GetSceneForLevel(Actor->GetLevel()), 0, 1);
+    }
+}
+
+void USceneManagerSubsystem::PublishSceneEvent(ESceneEventType Type, FName SceneName)
+{
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        FSceneEvent Event;
+        Event.Type = Type;
+        Event.SceneName = SceneName;
+        EventBus->Publish(Event);
+    }
+
+    switch (Type)
+    {
+        case ESceneEventType::Loaded:        OnSceneLoaded.Broadcast(SceneName); break;
+        case ESceneEventType::Unloaded:      OnSceneUnloaded.Broadcast(SceneName); break;
+        case ESceneEventType::Preloaded:     OnScenePreloaded.Broadcast(SceneName); break;
+        case ESceneEventType::Hidden:        OnSceneHidden.Broadcast(SceneName); break;
+        case ESceneEventType::StateCaptured: OnSceneStateCaptured.Broadcast(SceneName); break;
+        case ESceneEventType::StateRestored: OnSceneStateRestored.Broadcast(SceneName); break;
+    }
+}
+
+void USceneManagerSubsystem::PublishActorIndexChanged(FName SceneName, int32 ActorsAdded, int32 ActorsRemoved)
+{
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        FActorIndexChangedEvent Event;
+        Event.SceneName = SceneName;
+        Event.ActorsAdded = ActorsAdded;
+        Event.ActorsRemoved = ActorsRemoved;
+        EventBus->Publish(Event);
+    }
+
+    OnActorIndexChanged.Broadcast(SceneName, ActorsAdded, ActorsRemoved);
+}
+
+void USceneManagerSubsystem::ReindexActor(AActor* Actor)
+{
+    ActorIndex.AddActor(Actor);
+}
+
+TArray<AActor*> USceneManagerSubsystem::FindActorsByClass(TSubclassOf<AActor> ActorClass) const
+{
+    TArray<AActor*> Actors;
+    ActorIndex.FindByClass(ActorClass, Actors);
+    return Actors;
+}
+
+TArray<AActor*> USceneManagerSubsystem::FindActorsByTag(FName Tag) const
+{
+    TArray<AActor*> Actors;
+    ActorIndex.FindByTag(Tag, Actors);
+    return Actors;
+}
+
+TArray<AActor*> USceneManagerSubsystem::FindActorsInScene(FName SceneName) const
+{
+    TArray<AActor*> Actors;
+    ActorIndex.FindByScene(SceneName, Actors);
+    return Actors;
 }
 
-void USceneManagerSubsystem::OnPreviousSceneUnloaded(FName UnloadedScene)
+TArray<AActor*> USceneManagerSubsystem::FindActorsByMetadata(const FString& Value) const
 {
-    OnSceneUnloaded.RemoveDynamic(this, &USceneManagerSubsystem::OnPreviousSceneUnloaded);
-    ProcessNextSceneInQueue();
+    TArray<AActor*> Actors;
+    ActorIndex.FindByMetadata(Value, Actors);
+    return Actors;
 }
 
-void USceneManagerSubsystem::ProcessNextSceneInQueue()
+AActor* USceneManagerSubsystem::FindActorByMetadata(const FString& Value) const
 {
-    FName NextScene;
-    if (SceneQueue.Dequeue(NextScene)) LoadScene(NextScene);
+    return ActorIndex.FindFirstByMetadata(Value);
 }
@@ -0,0 +1,272 @@
+#include "Subsystems/SceneStateSnapshot.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/StructuredArchive.h"
+#include "UObject/ObjectKey.h"
+#include "Core/Logs.h"
+
+namespace TwinSceneState
+{
+    // Game thread only
+    static const TArray<FProperty*>& GetSaveGameProperties(const UClass* Class)
+    {
+        static TMap<FObjectKey, TArray<FProperty*>> Cache;
+
+        if (const TArray<FProperty*>* Found = Cache.Find(Class))
+        {
+            return *Found;
+        }
+
+        TArray<FProperty*>& Properties = Cache.Add(Class);
+        for (TFieldIterator<FProperty> It(Class); It; ++It)
+        {
+            if (It->HasAnyPropertyFlags(CPF_SaveGame))
+            {
+                Properties.Add(*It);
+            }
+        }
+        return Properties;
+    }
+
+    static void SerializeValue(FArchive& Inner, FProperty* Property, UObject* Object)
+    {
+        // Object and name references travel as paths so they survive a level reload
+        FObjectAndNameAsStringProxyArchive Ar(Inner, true);
+        Ar.ArIsSaveGame = true;
+        FStructuredArchiveFromArchive Structured(Ar);
+        for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+        {
+            Property->SerializeItem(Structured.GetSlot(), Property->ContainerPtrToValuePtr<void>(Object, Index));
+        }
+    }
+
+    static FString MakeObjectKey(const UObject* Object)
+    {
+        if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+        {
+            const AActor* Owner = Component->GetOwner();
+            return Owner ? Owner->GetName() + TEXT(".") + Component->GetName() : Component->GetName();
+        }
+        return Object->GetName();
+    }
+
+    static void AddLookup(TMap<FString, UObject*>& Lookup, AActor* Actor)
+    {
+        Lookup.Add(MakeObjectKey(Actor), Actor);
+        for (UActorComponent* Component : Actor->GetComponents())
+        {
+            if (Component)
+            {
+                Lookup.Add(MakeObjectKey(Component), Component);
+            }
+        }
+    }
+
+    void GatherObjects(const ULevel* Level, TArray<UObject*>& OutObjects)
+    {
+        if (!Level)
+        {
+            return;
+        }
+
+        for (AActor* Actor : Level->Actors)
+        {
+            if (!IsValid(Actor))
+            {
+                continue;
+            }
+
+            // Actors come before their components so restore can respawn the owner first
+            if (GetSaveGameProperties(Actor->GetClass()).Num() > 0)
+            {
+                OutObjects.Add(Actor);
+            }
+            for (UActorComponent* Component : Actor->GetComponents())
+            {
+                if (IsValid(Component) && GetSaveGameProperties(Component->GetClass()).Num() > 0)
+                {
+                    OutObjects.Add(Component);
+                }
+            }
+        }
+    }
+
+    int32 WriteObject(FArchive& Writer, UObject* Object)
+    {
+        const TArray<FProperty*>& Properties = GetSaveGameProperties(Object->GetClass());
+
+        FString Key = MakeObjectKey(Object);
+        FString ClassPath = Object->GetClass()->GetPathName();
+        AActor* Actor = Cast<AActor>(Object);
+        // Anything not loaded from the level package was spawned at runtime (annotations, overlays)
+        uint8 bSpawned = Actor && !Actor->HasAnyFlags(RF_WasLoaded) ? 1 : 0;
+        int32 NumProperties = Properties.Num();
+
+        Writer << Key << ClassPath << bSpawned;
+        if (bSpawned)
+        {
+            FTransform Transform = Actor->GetActorTransform();
+            Writer << Transform;
+        }
+        Writer << NumProperties;
+
+        TArray<uint8> Value;
+        for (FProperty* Property : Properties)
+        {
+            Value.Reset();
+            FMemoryWriter ValueWriter(Value);
+            SerializeValue(ValueWriter, Property, Object);
+
+            FName Name = Property->GetFName();
+            Writer << Name << Value;
+        }
+        return NumProperties;
+    }
+
+    FSceneStateRestoreStats Restore(ULevel* Level, const TArray<uint8>& RawData)
+    {
+        FSceneStateRestoreStats Stats;
+        if (!Level)
+        {
+            return Stats;
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+
+        TMap<FString, UObject*> Lookup;
+        for (AActor* Actor : Level->Actors)
+        {
+            if (IsValid(Actor))
+            {
+                AddLookup(Lookup, Actor);
+            }
+        }
+
+        FMemoryReader Reader(RawData);
+        TArray<uint8> Value;
+        TArray<uint8> Current;
+        while (!Reader.AtEnd() && !Reader.IsError())
+        {
+            FString Key;
+            FString ClassPath;
+            uint8 bSpawned = 0;
+            FTransform Transform;
+            int32 NumProperties = 0;
+
+            Reader << Key << ClassPath << bSpawned;
+            if (bSpawned)
+            {
+                Reader << Transform;
+            }
+            Reader << NumProperties;
+
+            UObject* Object = Lookup.FindRef(Key);
+            if (!Object && bSpawned)
+            {
+                UClass* ActorClass = FSoftClassPath(ClassPath).TryLoadClass<AActor>();
+                UWorld* World = Level->GetWorld();
+                if (ActorClass && World)
+                {
+                    FActorSpawnParameters Params;
+                    Params.OverrideLevel = Level;
+                    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+                    // Keep the recorded name so component records still match
+                    if (!StaticFindObjectFast(nullptr, Level, FName(*Key)))
+                    {
+                        Params.Name = FName(*Key);
+                    }
+
+                    if (AActor* Spawned = World->SpawnActor(ActorClass, &Transform, Params))
+                    {
+                        AddLookup(Lookup, Spawned);
+                        Object = Spawned;
+                        ++Stats.ActorsRespawned;
+                    }
+                }
+            }
+
+            const TArray<FProperty*>* Properties = Object ? &GetSaveGameProperties(Object->GetClass()) : nullptr;
+            bool bChanged = false;
+            for (int32 Index = 0; Index < NumProperties && !Reader.IsError(); ++Index)
+            {
+                FName Name;
+                Reader << Name << Value;
+
+                FProperty* const* Property = Properties
+                    ? Properties->FindByPredicate([Name](const FProperty* Candidate) { return Candidate->GetFName() == Name; })
+                    : nullptr;
+                if (!Property)
+                {
+                    continue;
+                }
+
+                Current.Reset();
+                FMemoryWriter CurrentWriter(Current);
+                SerializeValue(CurrentWriter, *Property, Object);
+                if (Current == Value)
+                {
+                    ++Stats.PropertiesUnchanged;
+                    continue;
+                }
+
+                FMemoryReader ValueReader(Value);
+                SerializeValue(ValueReader, *Property, Object);
+                ++Stats.PropertiesApplied;
+                bChanged = true;
+            }
+
+            if (!Object)
+            {
+                ++Stats.ObjectsMissing;
+                continue;
+            }
+
+            ++Stats.ObjectsRestored;
+            if (bChanged)
+            {
+                if (UActorComponent* Component = Cast<UActorComponent>(Object))
+                {
+                    Component->MarkRenderStateDirty();
+                }
+            }
+        }
+
+        if (Reader.IsError())
+        {
+            UE_LOG(LogScene, Warning, TEXT("Scene state snapshot for %s is truncated, restored what could be read"), *Level->GetOuter()->GetName());
+        }
+
+        Stats.Seconds = FPlatformTime::Seconds() - StartTime;
+        return Stats;
+    }
+
+    bool Compress(const TArray<uint8>& RawData, TArray<uint8>& OutCompressed)
+    {
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, RawData.Num());
+        OutCompressed.SetNumUninitialized(CompressedSize);
+        if (RawData.Num() == 0 || !FCompression::CompressMemory(NAME_Zlib, OutCompressed.GetData(), CompressedSize, RawData.GetData(), RawData.Num()))
+        {
+            OutCompressed.Reset();
+            return false;
+        }
+        OutCompressed.SetNum(CompressedSize);
+        return true;
+    }
+
+    bool Decompress(const TArray<uint8>& Compressed, int32 RawSize, TArray<uint8>& OutRawData)
+    {
+        OutRawData.SetNumUninitialized(RawSize);
+        if (RawSize <= 0 || !FCompression::UncompressMemory(NAME_Zlib, OutRawData.GetData(), RawSize, Compressed.GetData(), Compressed.Num()))
+        {
+            OutRawData.Reset();
+            return false;
+        }
+        return true;
+    }
+}
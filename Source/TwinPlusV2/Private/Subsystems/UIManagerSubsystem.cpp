@@ -1,10 +1,57 @@
 #include "Subsystems/UIManagerSubsystem.h"
 #include "Core/UILayer.h"
+#include "Subsystems/GlobalServices.h"
+#include "Subsystems/ModeManagerSubsystem.h"
+#include "Subsystems/EventBusSubsystem.h"
 #include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "PooledWidget.h"
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Framework/Application/SlateApplication.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Core/Logs.h"
 #include "UObject/ConstructorHelpers.h"
 
+namespace UIManagerConsole
+{
+    static FAutoConsoleCommandWithWorldAndArgs DumpPoolCommand(
+        TEXT("Twin.UI.DumpPool"),
+        TEXT("Logs widget pool hit rate, size and estimated savings"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            if (UUIManagerSubsystem* UIManager = UGlobalServices::GetUIManager(World))
+            {
+                const FUIWidgetPoolStats Stats = UIManager->GetWidgetPoolStats();
+                UE_LOG(LogUI, Display, TEXT("Widget pool: %d hits, %d misses (%.0f%%), %d discarded, %d pooled (%.1f KB), create %.3fms avg, ~%.1fms saved"),
+                    Stats.Hits, Stats.Misses, Stats.HitRate * 100.0f, Stats.Discarded, Stats.PooledWidgets,
+                    Stats.PooledBytes / 1024.0, Stats.AverageCreateMs, Stats.EstimatedSavedMs);
+            }
+        }));
+
+    static FAutoConsoleCommandWithWorldAndArgs DumpLayersCommand(
+        TEXT("Twin.UI.DumpLayers"),
+        TEXT("Logs stack depth and painted widgets per UI layer"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UUIManagerSubsystem* UIManager = UGlobalServices::GetUIManager(World);
+            UUIRootWidget* Root = UIManager ? UIManager->GetRootWidget() : nullptr;
+            if (!Root)
+            {
+                return;
+            }
+
+            const UEnum* LayerEnum = StaticEnum<EUILayer>();
+            for (int32 Index = 0; Index < LayerEnum->NumEnums() - 1; ++Index)
+            {
+                const EUILayer Layer = static_cast<EUILayer>(LayerEnum->GetValueByIndex(Index));
+                UE_LOG(LogUI, Display, TEXT("%s: %d pushed, %d painted%s"), *LayerEnum->GetNameStringByIndex(Index),
+                    UIManager->GetLayerDepth(Layer), Root->GetPaintedWidgetCount(Layer),
+                    UIManager->IsLayerVisible(Layer) ? TEXT("") : TEXT(", hidden"));
+            }
+        }));
+}
+
 void UUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
@@ -22,70 +69,803 @@ void UUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
         ensure(UIRegistry);
     }
 
+    // Mode entries start loading as soon as a mode is entered
+    EventBus = Collection.InitializeDependency<UEventBusSubsystem>();
+    if (EventBus)
+    {
+        ModeChangedHandle = EventBus->Subscribe(this, &UUIManagerSubsystem::HandleModeChanged);
+    }
+
+    // Without Slate (servers, commandlets) changes outside transactions apply right away
+    if (FSlateApplication::IsInitialized())
+    {
+        SlatePreTickHandle = FSlateApplication::Get().OnPreTick().AddUObject(this, &UUIManagerSubsystem::HandleSlatePreTick);
+    }
 }
 
 void UUIManagerSubsystem::PushUI(FName UIName, EUILayer Layer)
+{
+    if (!RecordIntent(EUIIntent::Push, UIName, Layer))
+    {
+        PushUINow(UIName, Layer);
+    }
+}
+
+void UUIManagerSubsystem::PushUIAsync(FName UIName, EUILayer Layer)
+{
+    if (!RecordIntent(EUIIntent::PushAsync, UIName, Layer))
+    {
+        PushUIAsyncNow(UIName, Layer);
+    }
+}
+
+void UUIManagerSubsystem::PushWidget(UUserWidget* Widget, EUILayer Layer, FName UIName, EUIWidgetOwnership Ownership)
+{
+    if (!Widget)
+    {
+        return;
+    }
+
+    if (!RecordIntent(EUIIntent::PushWidget, UIName, Layer, Widget, Ownership))
+    {
+        PushWidgetNow(Widget, Layer, UIName, Ownership);
+    }
+}
+
+bool UUIManagerSubsystem::RemoveWidget(UUserWidget* Widget)
+{
+    EUILayer Layer;
+    if (!Widget || !FindWidgetLayer(Widget, Layer))
+    {
+        return false;
+    }
+
+    if (!RecordIntent(EUIIntent::RemoveWidget, NAME_None, Layer, Widget))
+    {
+        return RemoveWidgetNow(Widget);
+    }
+    return true;
+}
+
+bool UUIManagerSubsystem::FindWidgetLayer(const UUserWidget* Widget, EUILayer& OutLayer) const
+{
+    // A recorded push decides where the widget will be
+    for (int32 Index = Intents.Num() - 1; Index >= 0; --Index)
+    {
+        if (Intents[Index].Type == EUIIntent::PushWidget && Intents[Index].Widget == Widget)
+        {
+            OutLayer = Intents[Index].Layer;
+            return true;
+        }
+    }
+
+    for (const auto& Pair : LayerStacks)
+    {
+        if (Pair.Value.Widgets.Contains(Widget))
+        {
+            OutLayer = Pair.Key;
+            return true;
+        }
+    }
+    return false;
+}
+
+void UUIManagerSubsystem::PopUI(EUILayer Layer)
+{
+    if (!RecordIntent(EUIIntent::Pop, NAME_None, Layer))
+    {
+        PopUINow(Layer);
+    }
+}
+
+bool UUIManagerSubsystem::RemoveUI(FName UIName, EUILayer Layer)
+{
+    if (!RecordIntent(EUIIntent::Remove, UIName, Layer))
+    {
+        return RemoveUINow(UIName, Layer);
+    }
+
+    const FUILayerStack* Stack = LayerStacks.Find(Layer);
+    const FPendingPush* Pending = PendingPushes.Find(Layer);
+    return (Stack && Stack->Names.Contains(UIName)) || (Pending && Pending->UIName == UIName);
+}
+
+void UUIManagerSubsystem::PopAllUI()
+{
+    if (!RecordIntent(EUIIntent::PopAll, NAME_None, EUILayer::HUD))
+    {
+        PopAllUINow();
+    }
+}
+
+void UUIManagerSubsystem::BeginUITransaction()
+{
+    ++TransactionDepth;
+}
+
+void UUIManagerSubsystem::EndUITransaction()
+{
+    if (!ensureMsgf(TransactionDepth > 0, TEXT("EndUITransaction without BeginUITransaction")))
+    {
+        return;
+    }
+
+    if (--TransactionDepth == 0)
+    {
+        ApplyIntents();
+    }
+}
+
+void UUIManagerSubsystem::FlushUIChanges()
+{
+    ApplyIntents();
+}
+
+bool UUIManagerSubsystem::RecordIntent(EUIIntent Type, FName UIName, EUILayer Layer, UUserWidget* Widget, EUIWidgetOwnership Ownership)
+{
+    if (TransactionDepth == 0 && (!bBatchUIChanges || !SlatePreTickHandle.IsValid()))
+    {
+        return false;
+    }
+
+    if (Type == EUIIntent::PopAll)
+    {
+        CancelledIntents += Intents.Num();
+        Intents.Reset();
+    }
+    else if (!IsPushIntent(Type))
+    {
+        // A pop takes back the latest push on its layer, a remove the latest push of its
+        // name or widget; pops and removes before that refer to widgets already on screen
+        for (int32 Index = Intents.Num() - 1; Index >= 0; --Index)
+        {
+            const FUIIntent& Intent = Intents[Index];
+            if (Intent.Type == EUIIntent::PopAll)
+            {
+                break;
+            }
+            if (Intent.Layer != Layer)
+            {
+                continue;
+            }
+            if (!IsPushIntent(Intent.Type))
+            {
+                break;
+            }
+            if (Type == EUIIntent::Pop
+                || (Type == EUIIntent::Remove && Intent.UIName == UIName)
+                || (Type == EUIIntent::RemoveWidget && Intent.Widget == Widget))
+            {
+                Intents.RemoveAt(Index, 1, EAllowShrinking::No);
+                CancelledIntents += 2;
+                return true;
+            }
+        }
+    }
+
+    FUIIntent& Intent = Intents.AddDefaulted_GetRef();
+    Intent.Type = Type;
+    Intent.UIName = UIName;
+    Intent.Layer = Layer;
+    Intent.Widget = Widget;
+    Intent.Ownership = Ownership;
+    return true;
+}
+
+void UUIManagerSubsystem::HandleSlatePreTick(float DeltaTime)
+{
+    if (TransactionDepth == 0)
+    {
+        ApplyIntents();
+    }
+}
+
+void UUIManagerSubsystem::ApplyIntents()
+{
+    if (bApplyingIntents || (Intents.Num() == 0 && CancelledIntents == 0))
+    {
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(UUIManagerSubsystem::ApplyIntents);
+
+    const TArray<FUIIntent> Applying = MoveTemp(Intents);
+    Intents.Reset();
+    const int32 Cancelled = CancelledIntents;
+    CancelledIntents = 0;
+
+    {
+        TGuardValue<bool> ApplyGuard(bApplyingIntents, true);
+        for (const FUIIntent& Intent : Applying)
+        {
+            switch (Intent.Type)
+            {
+            case EUIIntent::Push:         PushUINow(Intent.UIName, Intent.Layer); break;
+            case EUIIntent::PushAsync:    PushUIAsyncNow(Intent.UIName, Intent.Layer); break;
+            case EUIIntent::PushWidget:   PushWidgetNow(Intent.Widget.Get(), Intent.Layer, Intent.UIName, Intent.Ownership); break;
+            case EUIIntent::Pop:          PopUINow(Intent.Layer); break;
+            case EUIIntent::Remove:       RemoveUINow(Intent.UIName, Intent.Layer); break;
+            case EUIIntent::RemoveWidget: RemoveWidgetNow(Intent.Widget.Get()); break;
+            case EUIIntent::PopAll:       PopAllUINow(); break;
+            }
+        }
+    }
+
+    // Listeners see the final state; changes they make go into the next batch
+    const TArray<FUINotification> Notifications = MoveTemp(DeferredNotifications);
+    DeferredNotifications.Reset();
+
+    FUIChangesAppliedEvent Applied;
+    Applied.Cancelled = Cancelled;
+    for (const FUINotification& Notification : Notifications)
+    {
+        if (Notification.bPushed)
+        {
+            ++Applied.Pushed;
+            PublishPushed(Notification.UIName, Notification.Layer, Notification.Widget);
+        }
+        else
+        {
+            ++Applied.Popped;
+            PublishPopped(Notification.Layer, Notification.Widget);
+        }
+    }
+
+    if (EventBus)
+    {
+        EventBus->Publish(Applied);
+    }
+    OnUIChangesApplied.Broadcast(Applied.Pushed, Applied.Popped, Applied.Cancelled);
+
+    UE_LOG(LogUI, Verbose, TEXT("UIManagerSubsystem: Applied %d pushes and %d pops, %d changes cancelled"),
+        Applied.Pushed, Applied.Popped, Applied.Cancelled);
+}
+
+void UUIManagerSubsystem::PushUINow(FName UIName, EUILayer Layer)
 {
     if (!UIRegistry) return;
 
     const FUIEntry* Entry = UIRegistry->FindEntry(UIName);
     if (!Entry) return;
 
-    if (UClass* WidgetClass = Entry->WidgetClass.LoadSynchronous())
+    ClearPendingPush(Layer);
+
+    UModeManagerSubsystem* ModeManager = UGlobalServices::GetModeManager(this);
+    if (UClass* WidgetClass = ModeManager ? ModeManager->LoadClassForMode(Entry->WidgetClass) : Entry->WidgetClass.LoadSynchronous())
+    {
+        ShowWidget(UIName, Layer, WidgetClass);
+    }
+}
+
+UUIRootWidget* UUIManagerSubsystem::GetRootWidget()
+{
+    UWorld* World = GetWorld();
+    if (RootWidget && RootWidget->GetWorld() == World)
     {
-        if (UUserWidget** ExistingWidget = ActiveWidgets.Find(Layer))
+        if (!RootWidget->IsInViewport())
         {
-            if (*ExistingWidget) (*ExistingWidget)->RemoveFromParent();
-            ActiveWidgets.Remove(Layer);
+            RootWidget->AddToViewport();
         }
+        return RootWidget;
+    }
+
+    if (!World)
+    {
+        return nullptr;
+    }
 
-        UUserWidget* Widget = CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
-        if (Widget)
+    // Widgets of the previous world went with its viewport
+    if (RootWidget)
+    {
+        LayerStacks.Empty();
+        CallerOwnedWidgets.Empty();
+        PendingPushes.Empty();
+    }
+
+    RootWidget = CreateWidget<UUIRootWidget>(World, RootWidgetClass ? *RootWidgetClass : UUIRootWidget::StaticClass());
+    if (RootWidget)
+    {
+        for (const EUILayer Layer : HiddenLayers)
         {
-            Widget->AddToViewport(static_cast<int32>(Layer));
-            ActiveWidgets.Add(Layer, Widget);
-            OnUIPushed.Broadcast(UIName, Layer, Widget);
+            RootWidget->SetLayerHidden(Layer, true);
         }
+        RootWidget->AddToViewport();
     }
+    return RootWidget;
 }
 
-void UUIManagerSubsystem::PopUI(EUILayer Layer)
+UUserWidget* UUIManagerSubsystem::ShowWidget(FName UIName, EUILayer Layer, UClass* WidgetClass)
+{
+    UUIRootWidget* Root = GetRootWidget();
+    if (!Root)
+    {
+        return nullptr;
+    }
+
+    UUserWidget* Widget = AcquireWidget(UIName, WidgetClass);
+    if (Widget)
+    {
+        Root->AddToLayer(Layer, Widget);
+        FUILayerStack& Stack = LayerStacks.FindOrAdd(Layer);
+        Stack.Widgets.Add(Widget);
+        Stack.Names.Add(UIName);
+        PublishPushed(UIName, Layer, Widget);
+    }
+    return Widget;
+}
+
+void UUIManagerSubsystem::PushWidgetNow(UUserWidget* Widget, EUILayer Layer, FName UIName, EUIWidgetOwnership Ownership)
 {
-    if (UUserWidget** Found = ActiveWidgets.Find(Layer))
+    UUIRootWidget* Root = GetRootWidget();
+    if (!IsValid(Widget) || !Root)
     {
-        if (UUserWidget* Widget = *Found)
+        return;
+    }
+
+    ClearPendingPush(Layer);
+
+    // Already shown: moved to the top, without going through the pool
+    EUILayer CurrentLayer;
+    if (FindWidgetLayer(Widget, CurrentLayer))
+    {
+        const FUILayerStack& Current = LayerStacks.FindChecked(CurrentLayer);
+        if (CurrentLayer == Layer && Current.Widgets.Last() == Widget)
         {
-            Widget->RemoveFromParent();
-            OnUIPopped.Broadcast(Layer, Widget);
+            return;
         }
-        ActiveWidgets.Remove(Layer);
+        RemoveFromStack(CurrentLayer, Current.Widgets.Find(Widget), false);
     }
+
+    if (Ownership == EUIWidgetOwnership::Caller)
+    {
+        CallerOwnedWidgets.Add(Widget);
+    }
+
+    Root->AddToLayer(Layer, Widget);
+    FUILayerStack& Stack = LayerStacks.FindOrAdd(Layer);
+    Stack.Widgets.Add(Widget);
+    Stack.Names.Add(UIName);
+    PublishPushed(UIName, Layer, Widget);
 }
 
-void UUIManagerSubsystem::PopAllUI()
+bool UUIManagerSubsystem::RemoveWidgetNow(UUserWidget* Widget)
 {
-    for (auto& Pair : ActiveWidgets)
+    for (const auto& Pair : LayerStacks)
     {
-        if (UUserWidget* Widget = Pair.Value)
+        const int32 Index = Pair.Value.Widgets.Find(Widget);
+        if (Index != INDEX_NONE)
         {
-            EUILayer Layer = Pair.Key;
-            Widget->RemoveFromParent();
-            OnUIPopped.Broadcast(Layer, Widget); 
+            RemoveFromStack(Pair.Key, Index);
+            return true;
         }
     }
-    ActiveWidgets.Empty();
+    return false;
 }
 
-void UUIManagerSubsystem::Deinitialize()
+void UUIManagerSubsystem::RemoveFromStack(EUILayer Layer, int32 Index, bool bReleaseToPool)
 {
-    for (auto& Pair : ActiveWidgets)
+    FUILayerStack* Stack = LayerStacks.Find(Layer);
+    if (!Stack || !Stack->Widgets.IsValidIndex(Index))
     {
-        if (UUserWidget* Widget = Pair.Value)
+        return;
+    }
+
+    UUserWidget* Widget = Stack->Widgets[Index];
+    const FName UIName = Stack->Names[Index];
+    Stack->Widgets.RemoveAt(Index, 1, EAllowShrinking::No);
+    Stack->Names.RemoveAt(Index, 1, EAllowShrinking::No);
+
+    if (Widget)
+    {
+        if (RootWidget)
         {
-            Widget->RemoveFromParent();
+            RootWidget->RemoveFromLayer(Layer, Widget);
         }
+        Widget->RemoveFromParent();
+        PublishPopped(Layer, Widget);
+
+        const bool bCallerOwned = CallerOwnedWidgets.Remove(Widget) > 0;
+        if (bReleaseToPool && !bCallerOwned)
+        {
+            ReleaseWidget(UIName, Widget);
+        }
+    }
+}
+
+void UUIManagerSubsystem::ClearPendingPush(EUILayer Layer)
+{
+    FPendingPush Pending;
+    if (!PendingPushes.RemoveAndCopyValue(Layer, Pending))
+    {
+        return;
+    }
+
+    if (UUserWidget* Placeholder = Pending.Placeholder.Get())
+    {
+        if (const FUILayerStack* Stack = LayerStacks.Find(Layer))
+        {
+            RemoveFromStack(Layer, Stack->Widgets.Find(Placeholder));
+        }
+    }
+}
+
+void UUIManagerSubsystem::PushUIAsyncNow(FName UIName, EUILayer Layer)
+{
+    if (!UIRegistry) return;
+
+    const FUIEntry* Entry = UIRegistry->FindEntry(UIName);
+    if (!Entry) return;
+
+    UModeManagerSubsystem* ModeManager = UGlobalServices::GetModeManager(this);
+    if (!ModeManager || Entry->WidgetClass.Get() || Entry->WidgetClass.IsNull())
+    {
+        PushUINow(UIName, Layer);
+        return;
+    }
+
+    if (const FPendingPush* Existing = PendingPushes.Find(Layer))
+    {
+        if (Existing->UIName == UIName)
+        {
+            return;
+        }
+    }
+    ClearPendingPush(Layer);
+
+    FPendingPush Pending;
+    Pending.UIName = UIName;
+    if (const FUIEntry* Placeholder = AsyncPlaceholderUIName.IsNone() ? nullptr : UIRegistry->FindEntry(AsyncPlaceholderUIName))
+    {
+        if (UClass* PlaceholderClass = Placeholder->WidgetClass.Get())
+        {
+            Pending.Placeholder = ShowWidget(AsyncPlaceholderUIName, Layer, PlaceholderClass);
+        }
+    }
+    PendingPushes.Add(Layer, Pending);
+
+    TWeakObjectPtr<UUIManagerSubsystem> WeakThis(this);
+    ModeManager->LoadForModeAsync(Entry->WidgetClass.ToSoftObjectPath(), [WeakThis, UIName, Layer](UObject* Loaded)
+    {
+        if (UUIManagerSubsystem* This = WeakThis.Get())
+        {
+            This->HandleWidgetClassLoaded(UIName, Layer);
+        }
+    });
+}
+
+void UUIManagerSubsystem::HandleWidgetClassLoaded(FName UIName, EUILayer Layer)
+{
+    // Replaced or popped while loading
+    const FPendingPush* Pending = PendingPushes.Find(Layer);
+    if (!Pending || Pending->UIName != UIName)
+    {
+        return;
+    }
+
+    // PushUI would load a missing class synchronously, the hitch PushUIAsync is there to avoid
+    const FUIEntry* Entry = UIRegistry ? UIRegistry->FindEntry(UIName) : nullptr;
+    if (!Entry || !Entry->WidgetClass.Get())
+    {
+        UE_LOG(LogUI, Warning, TEXT("UIManagerSubsystem: Widget class of %s failed to load or its load was cancelled, dropping the async push"),
+            *UIName.ToString());
+        ClearPendingPush(Layer);
+        return;
+    }
+
+    PushUI(UIName, Layer);
+}
+
+void UUIManagerSubsystem::PreloadUIForMode(EAppMode Mode)
+{
+    UModeManagerSubsystem* ModeManager = UGlobalServices::GetModeManager(this);
+    if (!ModeManager || !UIRegistry) return;
+
+    for (const FUIEntry& Entry : UIRegistry->UIEntries)
+    {
+        if (Entry.Modes.Contains(Mode) && !Entry.WidgetClass.IsNull() && !Entry.WidgetClass.Get())
+        {
+            ModeManager->LoadForModeAsync(Entry.WidgetClass.ToSoftObjectPath(), [](UObject*) {});
+        }
+    }
+}
+
+void UUIManagerSubsystem::HandleModeChanged(const FModeChangedEvent& Event)
+{
+    PreloadUIForMode(Event.NewMode);
+}
+
+void UUIManagerSubsystem::PopUINow(EUILayer Layer)
+{
+    if (PendingPushes.Contains(Layer))
+    {
+        ClearPendingPush(Layer);
+        return;
+    }
+
+    if (const FUILayerStack* Stack = LayerStacks.Find(Layer))
+    {
+        RemoveFromStack(Layer, Stack->Widgets.Num() - 1);
+    }
+}
+
+bool UUIManagerSubsystem::RemoveUINow(FName UIName, EUILayer Layer)
+{
+    const FPendingPush* Pending = PendingPushes.Find(Layer);
+    if (Pending && Pending->UIName == UIName)
+    {
+        ClearPendingPush(Layer);
+        return true;
+    }
+
+    const FUILayerStack* Stack = LayerStacks.Find(Layer);
+    const int32 Index = Stack ? Stack->Names.FindLast(UIName) : INDEX_NONE;
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    RemoveFromStack(Layer, Index);
+    return true;
+}
+
+void UUIManagerSubsystem::PopAllUINow()
+{
+    TArray<EUILayer> Layers;
+    PendingPushes.GetKeys(Layers);
+    for (const EUILayer Layer : Layers)
+    {
+        ClearPendingPush(Layer);
+    }
+
+    LayerStacks.GetKeys(Layers);
+    for (const EUILayer Layer : Layers)
+    {
+        while (const FUILayerStack* Stack = LayerStacks.Find(Layer))
+        {
+            if (Stack->Widgets.Num() == 0)
+            {
+                break;
+            }
+            RemoveFromStack(Layer, Stack->Widgets.Num() - 1);
+        }
+    }
+    LayerStacks.Empty();
+}
+
+UUserWidget* UUIManagerSubsystem::GetTopWidget(EUILayer Layer) const
+{
+    const FUILayerStack* Stack = LayerStacks.Find(Layer);
+    return Stack && Stack->Widgets.Num() > 0 ? Stack->Widgets.Last().Get() : nullptr;
+}
+
+int32 UUIManagerSubsystem::GetLayerDepth(EUILayer Layer) const
+{
+    const FUILayerStack* Stack = LayerStacks.Find(Layer);
+    return Stack ? Stack->Widgets.Num() : 0;
+}
+
+void UUIManagerSubsystem::SetLayerVisible(EUILayer Layer, bool bVisible)
+{
+    if (bVisible)
+    {
+        HiddenLayers.Remove(Layer);
+    }
+    else
+    {
+        HiddenLayers.Add(Layer);
+    }
+
+    if (RootWidget)
+    {
+        RootWidget->SetLayerHidden(Layer, !bVisible);
+    }
+}
+
+bool UUIManagerSubsystem::IsLayerVisible(EUILayer Layer) const
+{
+    return !HiddenLayers.Contains(Layer);
+}
+
+UUserWidget* UUIManagerSubsystem::AcquireWidget(FName UIName, UClass* WidgetClass)
+{
+    if (FUIWidgetPool* Pool = WidgetPools.Find(UIName))
+    {
+        // Most recently popped first, it is the likeliest to still be warm
+        while (Pool->Widgets.Num() > 0)
+        {
+            UUserWidget* Widget = Pool->Widgets.Pop(EAllowShrinking::No);
+            PoolStats.PooledBytes -= Pool->WidgetBytes.Pop(EAllowShrinking::No);
+            --PoolStats.PooledWidgets;
+
+            // Widgets of an earlier world or a replaced class are not reused
+            if (IsValid(Widget) && Widget->GetClass() == WidgetClass && Widget->GetWorld() == GetWorld())
+            {
+                ++PoolStats.Hits;
+                if (Widget->Implements<UPooledWidget>())
+                {
+                    IPooledWidget::Execute_OnTakenFromPool(Widget);
+                }
+                return Widget;
+            }
+        }
+    }
+
+    ++PoolStats.Misses;
+    const double StartTime = FPlatformTime::Seconds();
+    UUserWidget* Widget = CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
+    TotalCreateSeconds += FPlatformTime::Seconds() - StartTime;
+    return Widget;
+}
+
+void UUIManagerSubsystem::ReleaseWidget(FName UIName, UUserWidget* Widget)
+{
+    const FUIEntry* Entry = UIRegistry ? UIRegistry->FindEntry(UIName) : nullptr;
+    if (!Entry || Entry->PoolSize <= 0 || !IsValid(Widget))
+    {
+        ++PoolStats.Discarded;
+        return;
+    }
+
+    FUIWidgetPool& Pool = WidgetPools.FindOrAdd(UIName);
+    if (Pool.Widgets.Num() >= Entry->PoolSize)
+    {
+        ++PoolStats.Discarded;
+        return;
+    }
+
+    if (Widget->Implements<UPooledWidget>())
+    {
+        IPooledWidget::Execute_OnReturnedToPool(Widget);
+    }
+
+    const int64 Bytes = EstimateWidgetBytes(Widget);
+    Pool.Widgets.Add(Widget);
+    Pool.WidgetBytes.Add(Bytes);
+    ++PoolStats.PooledWidgets;
+    PoolStats.PooledBytes += Bytes;
+
+    EnforceWidgetPoolBudget();
+}
+
+void UUIManagerSubsystem::EnforceWidgetPoolBudget()
+{
+    const int64 BudgetBytes = static_cast<int64>(WidgetPoolBudgetMB * 1024.0 * 1024.0);
+    while (PoolStats.PooledBytes > BudgetBytes)
+    {
+        // Oldest widget of the pool holding the most
+        FUIWidgetPool* Largest = nullptr;
+        int64 LargestBytes = 0;
+        for (auto& Pair : WidgetPools)
+        {
+            int64 PoolBytes = 0;
+            for (const int64 Bytes : Pair.Value.WidgetBytes)
+            {
+                PoolBytes += Bytes;
+            }
+            if (PoolBytes > LargestBytes)
+            {
+                Largest = &Pair.Value;
+                LargestBytes = PoolBytes;
+            }
+        }
+        if (!Largest)
+        {
+            break;
+        }
+
+        PoolStats.PooledBytes -= Largest->WidgetBytes[0];
+        --PoolStats.PooledWidgets;
+        ++PoolStats.Discarded;
+        Largest->Widgets.RemoveAt(0);
+        Largest->WidgetBytes.RemoveAt(0);
+    }
+}
+
+int64 UUIManagerSubsystem::EstimateWidgetBytes(const UUserWidget* Widget)
+{
+    // UObject sizes of the widget tree; Slate widgets are not counted
+    int64 Bytes = Widget->GetClass()->GetStructureSize();
+    if (Widget->WidgetTree)
+    {
+        Widget->WidgetTree->ForEachWidget([&Bytes](UWidget* Child)
+        {
+            Bytes += Child->GetClass()->GetStructureSize();
+        });
+    }
+    return Bytes;
+}
+
+FUIWidgetPoolStats UUIManagerSubsystem::GetWidgetPoolStats() const
+{
+    FUIWidgetPoolStats Stats = PoolStats;
+    const int32 Acquires = Stats.Hits + Stats.Misses;
+    Stats.HitRate = Acquires > 0 ? static_cast<float>(Stats.Hits) / Acquires : 0.0f;
+    Stats.AverageCreateMs = Stats.Misses > 0 ? static_cast<float>(TotalCreateSeconds * 1000.0 / Stats.Misses) : 0.0f;
+    Stats.EstimatedSavedMs = Stats.Hits * Stats.AverageCreateMs;
+    return Stats;
+}
+
+void UUIManagerSubsystem::EmptyWidgetPools()
+{
+    WidgetPools.Empty();
+    PoolStats.PooledWidgets = 0;
+    PoolStats.PooledBytes = 0;
+}
+
+void UUIManagerSubsystem::PublishPushed(FName UIName, EUILayer Layer, UUserWidget* Widget)
+{
+    if (bApplyingIntents)
+    {
+        DeferredNotifications.Add({ UIName, Layer, Widget, true });
+        return;
+    }
+
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        FUIPushedEvent Event;
+        Event.UIName = UIName;
+        Event.Layer = Layer;
+        Event.Widget = Widget;
+        EventBus->Publish(Event);
+    }
+    OnUIPushed.Broadcast(UIName, Layer, Widget);
+}
+
+void UUIManagerSubsystem::PublishPopped(EUILayer Layer, UUserWidget* Widget)
+{
+    if (bApplyingIntents)
+    {
+        DeferredNotifications.Add({ NAME_None, Layer, Widget, false });
+        return;
+    }
+
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        FUIPoppedEvent Event;
+        Event.Layer = Layer;
+        Event.Widget = Widget;
+        EventBus->Publish(Event);
+    }
+    OnUIPopped.Broadcast(Layer, Widget);
+}
+
+void UUIManagerSubsystem::GetWidgetClassesForMode(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths) const
+{
+    if (!UIRegistry) return;
+
+    for (const FUIEntry& Entry : UIRegistry->UIEntries)
+    {
+        if (Entry.Modes.Contains(Mode) && !Entry.WidgetClass.IsNull())
+        {
+            OutPaths.AddUnique(Entry.WidgetClass.ToSoftObjectPath());
+        }
+    }
+}
+
+void UUIManagerSubsystem::Deinitialize()
+{
+    if (SlatePreTickHandle.IsValid() && FSlateApplication::IsInitialized())
+    {
+        FSlateApplication::Get().OnPreTick().Remove(SlatePreTickHandle);
+    }
+    SlatePreTickHandle.Reset();
+    Intents.Reset();
+    TransactionDepth = 0;
+
+    if (RootWidget)
+    {
+        RootWidget->RemoveFromParent();
+        RootWidget = nullptr;
+    }
+    LayerStacks.Empty();
+    CallerOwnedWidgets.Empty();
+    PendingPushes.Empty();
+    EmptyWidgetPools();
+
+    if (EventBus)
+    {
+        EventBus->Unsubscribe(ModeChangedHandle);
     }
-    ActiveWidgets.Empty();
 
     Super::Deinitialize();
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "TwinPluginFramework/Core/TwinPluginManager.h"
 #include "Subsystems/GlobalServices.h"
 #include "Subsystems/ModeManagerSubsystem.h"
+#include "Subsystems/EventBusSubsystem.h"
+#include "TwinPluginFramework/Template/BasicToolTemplate.h"
 #include "Core/Logs.h"
 
 void UTwinPluginManager::Initialize(FSubsystemCollectionBase& Collection)
@@ -20,10 +22,11 @@ void UTwinPluginManager::Initialize(FSubsystemCollectionBase& Collection)
         PluginRegistry = NewObject<UTwinPluginRegistry>(this);
     }
 
-    // Listen to mode changes
-    if (UModeManagerSubsystem* ModeManager = UGlobalServices::GetModeManager(this))
+    // Listen to mode changes, ahead of other listeners so they see the new mode's tool set
+    EventBus = Collection.InitializeDependency<UEventBusSubsystem>();
+    if (EventBus)
     {
-        ModeManager->OnModeChanged.AddDynamic(this, &UTwinPluginManager::OnModeChanged);
+        ModeChangedHandle = EventBus->Subscribe(this, &UTwinPluginManager::HandleModeChanged, NAME_None, 100);
     }
 
     LoadRegisteredTools();
@@ -61,6 +64,7 @@ bool UTwinPluginManager::RegisterTool(const FString& ToolID, TSubclassOf<UObject
     NewTool.bEnabled = true;
 
     PluginRegistry->RegisterTool(NewTool);
+    PublishToolEvent(EToolEventType::Registered, ToolID, nullptr);
     OnToolRegistered.Broadcast(ToolID);
 
     return true;
@@ -85,10 +89,15 @@ TScriptInterface<ITwinToolInterface> UTwinPluginManager::CreateTool(const FStrin
     }
 
 
-    if (UClass* ToolClass = Tool.ToolClass.LoadSynchronous())
+    UModeManagerSubsystem* ModeManager = UGlobalServices::GetModeManager(this);
+    if (UClass* ToolClass = ModeManager ? ModeManager->LoadClassForMode(Tool.ToolClass) : Tool.ToolClass.LoadSynchronous())
     {
         UObject* NewTool = NewObject<UObject>(this, ToolClass);
         LoadedTools.Add(ToolID, NewTool);
+        if (UBasicToolTemplate* BasicTool = Cast<UBasicToolTemplate>(NewTool))
+        {
+            BasicTool->SetToolID(ToolID);
+        }
 
         if (NewTool->GetClass()->ImplementsInterface(UTwinToolInterface::StaticClass()))
         {
@@ -121,6 +130,7 @@ bool UTwinPluginManager::ActivateTool(const FString& ToolID)
 
     ITwinToolInterface::Execute_ActivateTool(Tool.GetObject());
     ActiveTools.Add(ToolID, Tool);
+    PublishToolEvent(EToolEventType::Activated, ToolID, Tool.GetObject());
     OnToolActivated.Broadcast(ToolID, Tool);
 
     return true;
@@ -156,6 +166,51 @@ void UTwinPluginManager::OnModeChanged(EAppMode NewMode)
     {
         DeactivateTool(ToolID);
     }
+
+    UnloadToolsForMode(NewMode);
+}
+
+void UTwinPluginManager::HandleModeChanged(const FModeChangedEvent& Event)
+{
+    OnModeChanged(Event.NewMode);
+}
+
+void UTwinPluginManager::PublishToolEvent(EToolEventType Type, const FString& ToolID, UObject* Tool)
+{
+    if (EventBus)
+    {
+        FToolEvent Event;
+        Event.Type = Type;
+        Event.ToolTopic = FName(*ToolID);
+        Event.Tool = Tool;
+        EventBus->Publish(Event);
+    }
+}
+
+void UTwinPluginManager::UnloadToolsForMode(EAppMode NewMode)
+{
+    // Idle instances the new mode cannot use would keep their classes and cached widgets alive
+    TArray<FString> ToolsToUnload;
+    for (const auto& ToolPair : LoadedTools)
+    {
+        UObject* ToolObject = ToolPair.Value;
+        if (!ToolObject || ActiveTools.Contains(ToolPair.Key) || PluginRegistry->FindTool(ToolPair.Key).bAutoLoad)
+        {
+            continue;
+        }
+
+        if (ToolObject->GetClass()->ImplementsInterface(UTwinToolInterface::StaticClass())
+            && !ITwinToolInterface::Execute_CanActivateInMode(ToolObject, NewMode))
+        {
+            ToolsToUnload.Add(ToolPair.Key);
+        }
+    }
+
+    for (const FString& ToolID : ToolsToUnload)
+    {
+        ITwinToolInterface::Execute_ShutdownTool(LoadedTools.FindAndRemoveChecked(ToolID));
+        UE_LOG(LogMode, Log, TEXT("Unloaded idle tool: %s"), *ToolID);
+    }
 }
 
 void UTwinPluginManager::DeactivateTool(const FString& ToolID)
@@ -166,8 +221,10 @@ void UTwinPluginManager::DeactivateTool(const FString& ToolID)
         return;
     }
 
-    ITwinToolInterface::Execute_DeactivateTool(FoundTool->GetObject());
+    UObject* ToolObject = FoundTool->GetObject();
+    ITwinToolInterface::Execute_DeactivateTool(ToolObject);
     ActiveTools.Remove(ToolID);
+    PublishToolEvent(EToolEventType::Deactivated, ToolID, ToolObject);
     OnToolDeactivated.Broadcast(ToolID);
 
     UE_LOG(LogMode, Log, TEXT("Deactivated tool: %s"), *ToolID);
@@ -265,6 +322,17 @@ FToolMetadata UTwinPluginManager::GetToolMetadata(const FString& ToolID) const
     return FToolMetadata();
 }
 
+const TArray<FRegisteredTool>& UTwinPluginManager::GetRegisteredTools() const
+{
+    static const TArray<FRegisteredTool> NoTools;
+    return PluginRegistry ? PluginRegistry->RegisteredTools : NoTools;
+}
+
+const FRegisteredTool* UTwinPluginManager::FindRegisteredTool(const FString& ToolID) const
+{
+    return PluginRegistry ? PluginRegistry->FindToolEntry(ToolID) : nullptr;
+}
+
 bool UTwinPluginManager::IsToolActive(const FString& ToolID) const
 {
     return ActiveTools.Contains(ToolID);
@@ -304,6 +372,39 @@ TArray<FString> UTwinPluginManager::GetToolsForCurrentMode() const
     return ModeTools;
 }
 
+void UTwinPluginManager::GetToolAssetsForMode(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths) const
+{
+    if (!PluginRegistry) return;
+
+    for (const FRegisteredTool& Tool : PluginRegistry->RegisteredTools)
+    {
+        if (!Tool.bEnabled || Tool.ToolClass.IsNull())
+        {
+            continue;
+        }
+
+        if (!Tool.Metadata.SupportedModes.IsEmpty() && !Tool.Metadata.SupportedModes.Contains(Mode))
+        {
+            continue;
+        }
+
+        // The class has to be resident before its defaults can name the rest
+        UClass* ToolClass = Tool.ToolClass.Get();
+        if (!ToolClass)
+        {
+            OutPaths.AddUnique(Tool.ToolClass.ToSoftObjectPath());
+            if (!Tool.Metadata.Icon.IsNull())
+            {
+                OutPaths.AddUnique(Tool.Metadata.Icon.ToSoftObjectPath());
+            }
+        }
+        else if (const UBasicToolTemplate* ToolDefaults = Cast<UBasicToolTemplate>(ToolClass->GetDefaultObject()))
+        {
+            ToolDefaults->GetPrewarmAssets(Mode, OutPaths);
+        }
+    }
+}
+
 bool UTwinPluginManager::ValidateToolClass(TSubclassOf<UObject> ToolClass) const
 {
     if (!ToolClass)
@@ -338,10 +439,9 @@ void UTwinPluginManager::Deinitialize()
 {
     UnloadAllTools();
 
-    // Remove mode manager delegate
-    if (UModeManagerSubsystem* ModeManager = UGlobalServices::GetModeManager(this))
+    if (EventBus)
     {
-        ModeManager->OnModeChanged.RemoveDynamic(this, &UTwinPluginManager::OnModeChanged);
+        EventBus->Unsubscribe(ModeChangedHandle);
     }
 
     Super::Deinitialize();
@@ -368,6 +468,7 @@ bool UTwinPluginManager::UnregisterTool(const FString& ToolID)
         // Remove from loaded tools
         LoadedTools.Remove(ToolID);
 
+        PublishToolEvent(EToolEventType::Unregistered, ToolID, nullptr);
         OnToolUnregistered.Broadcast(ToolID);
         UE_LOG(LogMode, Log, TEXT("Unregistered tool: %s"), *ToolID);
     }
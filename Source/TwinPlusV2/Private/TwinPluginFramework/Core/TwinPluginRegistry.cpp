@@ -1,13 +1,11 @@
 #include "TwinPluginFramework/Core/TwinPluginRegistry.h"
+#include "Core/Logs.h"
 
 FRegisteredTool UTwinPluginRegistry::FindTool(const FString& ToolID) const
 {
-    for (const FRegisteredTool& Tool : RegisteredTools)
+    if (const FRegisteredTool* Tool = FindToolEntry(ToolID))
     {
-        if (Tool.ToolID == ToolID)
-        {
-            return Tool;
-        }
+        return *Tool;
     }
 
     return FRegisteredTool();
@@ -41,15 +39,14 @@ TArray<FRegisteredTool> UTwinPluginRegistry::GetToolsForMode(EAppMode Mode) cons
 
 void UTwinPluginRegistry::RegisterTool(const FRegisteredTool& Tool)
 {
-    for (FRegisteredTool& ExistingTool : RegisteredTools)
+    const int32 Existing = ToolIndex.FindIndex(RegisteredTools, Tool.ToolID);
+    if (Existing != INDEX_NONE)
     {
-        if (ExistingTool.ToolID == Tool.ToolID)
-        {
-            ExistingTool = Tool;
-            return;
-        }
+        RegisteredTools[Existing] = Tool;
+        return;
     }
     RegisteredTools.Add(Tool);
+    ToolIndex.OnAppended(RegisteredTools);
 }
 
 bool UTwinPluginRegistry::UnregisterTool(const FString& ToolID)
@@ -59,8 +56,33 @@ bool UTwinPluginRegistry::UnregisterTool(const FString& ToolID)
         if (RegisteredTools[i].ToolID == ToolID)
         {
             RegisteredTools.RemoveAt(i);
+            RebuildIndex();
             return true;
         }
     }
     return false;
-}
\ No newline at end of file
+}
+
+void UTwinPluginRegistry::RebuildIndex()
+{
+    const int32 Duplicates = ToolIndex.Rebuild(RegisteredTools);
+
+    if (Duplicates > 0)
+    {
+        UE_LOG(LogMode, Warning, TEXT("%s: %d duplicate tool IDs, only the first of each is used"), *GetName(), Duplicates);
+    }
+}
+
+void UTwinPluginRegistry::PostLoad()
+{
+    Super::PostLoad();
+    RebuildIndex();
+}
+
+#if WITH_EDITOR
+void UTwinPluginRegistry::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    RebuildIndex();
+}
+#endif
\ No newline at end of file
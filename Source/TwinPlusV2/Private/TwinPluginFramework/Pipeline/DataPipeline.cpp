@@ -0,0 +1,388 @@
+#include "TwinPluginFramework/Pipeline/DataPipeline.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Core/Logs.h"
+
+struct FDataPipelineSharedState
+{
+    std::atomic<bool> bCancelled{false};
+    std::atomic<float> SourceProgress{0.0f};
+};
+
+/** Queue between two stages plus the events used to park the producer/consumer */
+struct FDataPipelineChannel
+{
+    explicit FDataPipelineChannel(int32 Capacity)
+        : Queue(Capacity)
+    {
+    }
+
+    TDataPipelineQueue<FDataPipelinePacket> Queue;
+    FEventRef DataAvailable{EEventMode::AutoReset};
+    FEventRef SpaceAvailable{EEventMode::AutoReset};
+    std::atomic<bool> bProducerDone{false};
+};
+
+class FDataPipelineStageRunner : public FRunnable, public FDataPipelineEmitter
+{
+public:
+    FDataPipelineStageRunner(UDataProcessorTemplate* InProcessor, TSharedPtr<FDataPipelineSharedState> InShared,
+        TSharedPtr<FDataPipelineChannel> InInput, TSharedPtr<FDataPipelineChannel> InOutput)
+        : Processor(InProcessor)
+        , Shared(MoveTemp(InShared))
+        , Input(MoveTemp(InInput))
+        , Output(MoveTemp(InOutput))
+    {
+    }
+
+    virtual ~FDataPipelineStageRunner() override
+    {
+        Join();
+    }
+
+    void Start(const FString& ThreadName)
+    {
+        Thread.Reset(FRunnableThread::Create(this, *ThreadName));
+    }
+
+    void Join()
+    {
+        if (Thread)
+        {
+            Thread->WaitForCompletion();
+            Thread.Reset();
+        }
+    }
+
+    // FRunnable
+    virtual uint32 Run() override
+    {
+        StartSeconds.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+        bool bOk = true;
+
+        if (!Input)
+        {
+            bOk = Processor->ProducePipelinePackets(*this);
+        }
+        else
+        {
+            FDataPipelinePacket Packet;
+            while (bOk && !IsCancelled())
+            {
+                if (Input->Queue.TryPop(Packet))
+                {
+                    Input->SpaceAvailable->Trigger();
+
+                    const int32 NumItems = Packet.Num();
+                    const uint64 BusyStart = FPlatformTime::Cycles64();
+                    {
+                        FProcessorArenaScope ArenaScope(FProcessorArena::GetThreadArena());
+                        bOk = Processor->ProcessPipelinePacket(MoveTemp(Packet), *this);
+                    }
+                    BusyCycles.fetch_add(FPlatformTime::Cycles64() - BusyStart, std::memory_order_relaxed);
+
+                    PacketsIn.fetch_add(1, std::memory_order_relaxed);
+                    ItemsIn.fetch_add(NumItems, std::memory_order_relaxed);
+                }
+                // Check the done flag before emptiness so a late push is never missed
+                else if (Input->bProducerDone.load(std::memory_order_acquire) && Input->Queue.IsEmpty())
+                {
+                    break;
+                }
+                else
+                {
+                    Input->DataAvailable->Wait(5);
+                }
+            }
+
+            if (bOk && !IsCancelled())
+            {
+                bOk = Processor->FlushPipelineStage(*this);
+            }
+        }
+
+        if (!bOk)
+        {
+            Shared->bCancelled.store(true);
+        }
+
+        EndSeconds.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+        bSucceeded.store(bOk && !IsCancelled());
+        bFinished.store(true, std::memory_order_release);
+
+        if (Output)
+        {
+            Output->bProducerDone.store(true, std::memory_order_release);
+            Output->DataAvailable->Trigger();
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        Shared->bCancelled.store(true);
+    }
+
+    // FDataPipelineEmitter
+    virtual bool Emit(FDataPipelinePacket&& Packet) override
+    {
+        if (Packet.Sequence == INDEX_NONE)
+        {
+            Packet.Sequence = NextSequence++;
+        }
+
+        const int32 NumItems = Packet.Num();
+        if (Output)
+        {
+            while (!Output->Queue.TryPush(MoveTemp(Packet)))
+            {
+                if (IsCancelled())
+                {
+                    return false;
+                }
+
+                const uint64 WaitStart = FPlatformTime::Cycles64();
+                Output->SpaceAvailable->Wait(5);
+                BlockedCycles.fetch_add(FPlatformTime::Cycles64() - WaitStart, std::memory_order_relaxed);
+            }
+            Output->DataAvailable->Trigger();
+        }
+
+        PacketsOut.fetch_add(1, std::memory_order_relaxed);
+        ItemsOut.fetch_add(NumItems, std::memory_order_relaxed);
+        return !IsCancelled();
+    }
+
+    virtual void ReportProgress(float Progress) override
+    {
+        if (!Input)
+        {
+            Shared->SourceProgress.store(FMath::Clamp(Progress, 0.0f, 1.0f), std::memory_order_relaxed);
+        }
+    }
+
+    virtual bool IsCancelled() const override
+    {
+        return Shared->bCancelled.load(std::memory_order_relaxed);
+    }
+
+    UDataProcessorTemplate* Processor = nullptr;
+    TSharedPtr<FDataPipelineSharedState> Shared;
+    TSharedPtr<FDataPipelineChannel> Input;
+    TSharedPtr<FDataPipelineChannel> Output;
+    TUniquePtr<FRunnableThread> Thread;
+
+    // Worker thread only
+    int64 NextSequence = 0;
+
+    // Written by the worker, read by GetStageStats on the game thread
+    std::atomic<double> StartSeconds{0.0};
+    std::atomic<double> EndSeconds{0.0};
+    std::atomic<uint64> BusyCycles{0};
+
+    std::atomic<int64> PacketsIn{0};
+    std::atomic<int64> ItemsIn{0};
+    std::atomic<int64> PacketsOut{0};
+    std::atomic<int64> ItemsOut{0};
+    std::atomic<uint64> BlockedCycles{0};
+    std::atomic<bool> bFinished{false};
+    std::atomic<bool> bSucceeded{false};
+};
+
+bool UDataPipeline::AddStage(UDataProcessorTemplate* Processor)
+{
+    if (bIsRunning)
+    {
+        UE_LOG(LogMode, Warning, TEXT("Cannot add stages while the pipeline is running"));
+        return false;
+    }
+
+    if (!Processor)
+    {
+        return false;
+    }
+
+    Stages.Add(Processor);
+    return true;
+}
+
+void UDataPipeline::ClearStages()
+{
+    if (bIsRunning)
+    {
+        UE_LOG(LogMode, Warning, TEXT("Cannot clear stages while the pipeline is running"));
+        return;
+    }
+
+    Stages.Empty();
+}
+
+bool UDataPipeline::StartPipeline()
+{
+    if (bIsRunning)
+    {
+        UE_LOG(LogMode, Warning, TEXT("Pipeline already running"));
+        return false;
+    }
+
+    if (Stages.IsEmpty())
+    {
+        UE_LOG(LogMode, Error, TEXT("Cannot start pipeline without stages"));
+        return false;
+    }
+
+    Runners.Reset();
+    SharedState = MakeShared<FDataPipelineSharedState>();
+
+    TSharedPtr<FDataPipelineChannel> Input;
+    for (int32 Index = 0; Index < Stages.Num(); ++Index)
+    {
+        TSharedPtr<FDataPipelineChannel> Output;
+        if (Index < Stages.Num() - 1)
+        {
+            Output = MakeShared<FDataPipelineChannel>(QueueCapacity);
+        }
+
+        Runners.Add(MakeShared<FDataPipelineStageRunner>(Stages[Index], SharedState, Input, Output));
+        Input = Output;
+    }
+
+    bIsRunning = true;
+    StartTime = FPlatformTime::Seconds();
+
+    for (int32 Index = 0; Index < Runners.Num(); ++Index)
+    {
+        Runners[Index]->Start(FString::Printf(TEXT("DataPipeline_%d_%s"), Index, *Stages[Index]->GetName()));
+    }
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UDataPipeline::TickPipeline), ProgressInterval);
+
+    UE_LOG(LogMode, Log, TEXT("Started pipeline with %d stages, queue capacity %d"), Stages.Num(), QueueCapacity);
+    return true;
+}
+
+void UDataPipeline::CancelPipeline()
+{
+    if (!bIsRunning)
+    {
+        return;
+    }
+
+    UE_LOG(LogMode, Log, TEXT("Cancelling pipeline"));
+    StopRunners();
+    OnPipelineComplete.Broadcast(false, TEXT("Pipeline cancelled"));
+}
+
+void UDataPipeline::StopRunners()
+{
+    if (SharedState)
+    {
+        SharedState->bCancelled.store(true);
+    }
+
+    for (const TSharedPtr<FDataPipelineStageRunner>& Runner : Runners)
+    {
+        Runner->Join();
+    }
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    bIsRunning = false;
+}
+
+TArray<FDataPipelineStageStats> UDataPipeline::GetStageStats() const
+{
+    TArray<FDataPipelineStageStats> Result;
+    const double Now = FPlatformTime::Seconds();
+    const float SourceProgress = SharedState ? SharedState->SourceProgress.load(std::memory_order_relaxed) : 0.0f;
+
+    for (int32 Index = 0; Index < Runners.Num(); ++Index)
+    {
+        const FDataPipelineStageRunner& Runner = *Runners[Index];
+
+        FDataPipelineStageStats& Stats = Result.AddDefaulted_GetRef();
+        Stats.StageName = Stages.IsValidIndex(Index) && Stages[Index] ? Stages[Index]->GetName() : FString();
+        Stats.bFinished = Runner.bFinished.load(std::memory_order_acquire);
+        Stats.PacketsProcessed = Runner.Input ? Runner.PacketsIn.load() : Runner.PacketsOut.load();
+        Stats.ItemsProcessed = Runner.Input ? Runner.ItemsIn.load() : Runner.ItemsOut.load();
+        Stats.ItemsEmitted = Runner.ItemsOut.load();
+        Stats.BlockedSeconds = static_cast<float>(FPlatformTime::ToSeconds64(Runner.BlockedCycles.load()));
+        Stats.InputQueueDepth = Runner.Input ? Runner.Input->Queue.Num() : 0;
+
+        // Zero until the worker has started
+        const double StageStart = Runner.StartSeconds.load(std::memory_order_relaxed);
+        const double Elapsed = StageStart > 0.0 ? (Stats.bFinished ? Runner.EndSeconds.load(std::memory_order_relaxed) : Now) - StageStart : 0.0;
+        Stats.ItemsPerSecond = Elapsed > 0.0 ? static_cast<float>(Stats.ItemsProcessed / Elapsed) : 0.0f;
+
+        if (Stats.bFinished)
+        {
+            Stats.Progress = 1.0f;
+        }
+        else if (!Runner.Input)
+        {
+            Stats.Progress = SourceProgress;
+        }
+        else
+        {
+            // Downstream stages trail the source by whatever is still queued upstream
+            const int64 UpstreamEmitted = Runners[Index - 1]->PacketsOut.load();
+            const float Drained = UpstreamEmitted > 0 ? static_cast<float>(Stats.PacketsProcessed) / static_cast<float>(UpstreamEmitted) : 0.0f;
+            Stats.Progress = FMath::Min(Result[Index - 1].Progress, SourceProgress * Drained);
+        }
+    }
+
+    return Result;
+}
+
+bool UDataPipeline::TickPipeline(float DeltaTime)
+{
+    const TArray<FDataPipelineStageStats> Stats = GetStageStats();
+    for (int32 Index = 0; Index < Stats.Num(); ++Index)
+    {
+        OnStageProgress.Broadcast(Index, Stats[Index]);
+    }
+
+    for (const TSharedPtr<FDataPipelineStageRunner>& Runner : Runners)
+    {
+        if (!Runner->bFinished.load(std::memory_order_acquire))
+        {
+            return true;
+        }
+    }
+
+    bool bSuccess = !SharedState->bCancelled.load();
+    for (const TSharedPtr<FDataPipelineStageRunner>& Runner : Runners)
+    {
+        bSuccess &= Runner->bSucceeded.load();
+    }
+
+    for (const FDataPipelineStageStats& Stage : Stats)
+    {
+        UE_LOG(LogMode, Log, TEXT("Pipeline stage %s: %lld items, %.0f items/s, blocked %.2fs"),
+            *Stage.StageName, Stage.ItemsProcessed, Stage.ItemsPerSecond, Stage.BlockedSeconds);
+    }
+
+    // Threads have finished, this only joins them
+    TickerHandle.Reset();
+    StopRunners();
+
+    const FString Result = FString::Printf(TEXT("Pipeline %s in %.2fs"),
+        bSuccess ? TEXT("completed") : TEXT("failed"), FPlatformTime::Seconds() - StartTime);
+    UE_LOG(LogMode, Log, TEXT("%s"), *Result);
+
+    OnPipelineComplete.Broadcast(bSuccess, Result);
+    return false;
+}
+
+void UDataPipeline::BeginDestroy()
+{
+    StopRunners();
+    Runners.Reset();
+    Super::BeginDestroy();
+}
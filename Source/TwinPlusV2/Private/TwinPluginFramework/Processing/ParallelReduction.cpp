@@ -0,0 +1,186 @@
+#include "TwinPluginFramework/Processing/ParallelReduction.h"
+
+void FWelfordAccumulator::Merge(const FWelfordAccumulator& Other)
+{
+    if (Other.Count == 0)
+    {
+        return;
+    }
+
+    if (Count == 0)
+    {
+        *this = Other;
+        return;
+    }
+
+    const double CountA = static_cast<double>(Count);
+    const double CountB = static_cast<double>(Other.Count);
+    const double Total = CountA + CountB;
+    const double Delta = Other.Mean - Mean;
+
+    Mean += Delta * (CountB / Total);
+    M2 += Other.M2 + Delta * Delta * (CountA * CountB / Total);
+    Count += Other.Count;
+}
+
+double FWelfordAccumulator::GetVariance(bool bSample) const
+{
+    const int64 Denominator = bSample ? Count - 1 : Count;
+    return Denominator > 0 ? M2 / static_cast<double>(Denominator) : 0.0;
+}
+
+FHistogramAccumulator::FHistogramAccumulator(double InRangeMin, double InRangeMax, int32 NumBins)
+    : RangeMin(InRangeMin)
+    , RangeMax(FMath::Max(InRangeMax, InRangeMin + UE_DOUBLE_SMALL_NUMBER))
+{
+    Bins.SetNumZeroed(FMath::Max(NumBins, 1));
+    InvBinWidth = static_cast<double>(Bins.Num()) / (RangeMax - RangeMin);
+}
+
+void FHistogramAccumulator::Merge(const FHistogramAccumulator& Other)
+{
+    checkf(Bins.Num() == Other.Bins.Num() && RangeMin == Other.RangeMin && RangeMax == Other.RangeMax,
+        TEXT("Histogram partials must share range and bin count"));
+
+    Underflow += Other.Underflow;
+    Overflow += Other.Overflow;
+    Dropped += Other.Dropped;
+    for (int32 Index = 0; Index < Bins.Num(); ++Index)
+    {
+        Bins[Index] += Other.Bins[Index];
+    }
+}
+
+int64 FHistogramAccumulator::GetTotalCount() const
+{
+    int64 Total = Underflow + Overflow + Dropped;
+    for (const int64 BinCount : Bins)
+    {
+        Total += BinCount;
+    }
+    return Total;
+}
+
+FQuantileSketch::FQuantileSketch(double InRelativeAccuracy)
+    : RelativeAccuracy(FMath::Clamp(InRelativeAccuracy, 1e-4, 0.5))
+{
+    Gamma = (1.0 + RelativeAccuracy) / (1.0 - RelativeAccuracy);
+    InvLogGamma = 1.0 / FMath::Loge(Gamma);
+}
+
+int32 FQuantileSketch::GetBucketIndex(double AbsValue) const
+{
+    return FMath::CeilToInt32(FMath::Loge(AbsValue) * InvLogGamma);
+}
+
+double FQuantileSketch::GetBucketValue(int32 Index) const
+{
+    // Midpoint of (Gamma^(i-1), Gamma^i] in the relative-error sense
+    return 2.0 * FMath::Pow(Gamma, static_cast<double>(Index)) / (Gamma + 1.0);
+}
+
+void FQuantileSketch::FBucketStore::Increment(int32 Index, int64 Amount)
+{
+    if (Counts.IsEmpty())
+    {
+        MinIndex = Index;
+        Counts.Add(0);
+    }
+    else if (Index < MinIndex)
+    {
+        Counts.InsertZeroed(0, MinIndex - Index);
+        MinIndex = Index;
+    }
+    else if (Index >= MinIndex + Counts.Num())
+    {
+        Counts.AddZeroed(Index - MinIndex - Counts.Num() + 1);
+    }
+
+    Counts[Index - MinIndex] += Amount;
+}
+
+void FQuantileSketch::FBucketStore::Merge(const FBucketStore& Other)
+{
+    for (int32 Offset = 0; Offset < Other.Counts.Num(); ++Offset)
+    {
+        if (Other.Counts[Offset] != 0)
+        {
+            Increment(Other.MinIndex + Offset, Other.Counts[Offset]);
+        }
+    }
+}
+
+void FQuantileSketch::Add(double Value)
+{
+    // The bucket index of a NaN or infinity is undefined and would size the store without bound
+    if (!FMath::IsFinite(Value))
+    {
+        ++Dropped;
+        return;
+    }
+
+    ++Count;
+
+    const double AbsValue = FMath::Abs(Value);
+    if (AbsValue < UE_DOUBLE_SMALL_NUMBER)
+    {
+        ++ZeroCount;
+    }
+    else if (Value > 0.0)
+    {
+        Positive.Increment(GetBucketIndex(AbsValue), 1);
+    }
+    else
+    {
+        Negative.Increment(GetBucketIndex(AbsValue), 1);
+    }
+}
+
+void FQuantileSketch::Merge(const FQuantileSketch& Other)
+{
+    checkf(RelativeAccuracy == Other.RelativeAccuracy, TEXT("Quantile sketches must share the same accuracy"));
+
+    Count += Other.Count;
+    ZeroCount += Other.ZeroCount;
+    Dropped += Other.Dropped;
+    Positive.Merge(Other.Positive);
+    Negative.Merge(Other.Negative);
+}
+
+double FQuantileSketch::GetQuantile(double Quantile) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+
+    const int64 Rank = static_cast<int64>(FMath::Clamp(Quantile, 0.0, 1.0) * static_cast<double>(Count - 1));
+    int64 Seen = 0;
+
+    // Negative values, most negative (highest bucket) first
+    for (int32 Offset = Negative.Counts.Num() - 1; Offset >= 0; --Offset)
+    {
+        Seen += Negative.Counts[Offset];
+        if (Seen > Rank)
+        {
+            return -GetBucketValue(Negative.MinIndex + Offset);
+        }
+    }
+
+    Seen += ZeroCount;
+    if (Seen > Rank)
+    {
+        return 0.0;
+    }
+
+    for (int32 Offset = 0; Offset < Positive.Counts.Num(); ++Offset)
+    {
+        Seen += Positive.Counts[Offset];
+        if (Seen > Rank)
+        {
+            return GetBucketValue(Positive.MinIndex + Offset);
+        }
+    }
+
+    return GetBucketValue(Positive.MinIndex + Positive.Counts.Num() - 1);
+}
@@ -0,0 +1,116 @@
+#include "TwinPluginFramework/Processing/ProcessorArena.h"
+
+namespace ProcessorArena
+{
+    static thread_local FProcessorArena* CurrentArena = nullptr;
+}
+
+FProcessorArena::FProcessorArena(SIZE_T InChunkSize)
+    : ChunkSize(FMath::Max<SIZE_T>(InChunkSize, 4 * 1024))
+{
+}
+
+FProcessorArena::~FProcessorArena()
+{
+    checkf(ProcessorArena::CurrentArena != this, TEXT("Destroying an arena that is still current"));
+
+    for (const FChunk& Chunk : Chunks)
+    {
+        FMemory::Free(Chunk.Data);
+    }
+}
+
+void* FProcessorArena::Allocate(SIZE_T Size, uint32 Alignment)
+{
+    ++AllocationCount;
+
+    // DEFAULT_ALIGNMENT is 0, fall back to the minimum FMemory guarantees
+    Alignment = FMath::Max<uint32>(Alignment, 16);
+
+    while (true)
+    {
+        if (Chunks.IsValidIndex(CurrentChunk))
+        {
+            const FChunk& Chunk = Chunks[CurrentChunk];
+            // Align the address, chunks are only aligned for the allocation that created them
+            const SIZE_T AlignedOffset = static_cast<SIZE_T>(Align(Chunk.Data + Offset, Alignment) - Chunk.Data);
+            if (AlignedOffset + Size <= Chunk.Size)
+            {
+                Offset = AlignedOffset + Size;
+                PeakBytesUsed = FMath::Max(PeakBytesUsed, GetBytesUsed());
+                return Chunk.Data + AlignedOffset;
+            }
+
+            // Move on to the next chunk, the tail of this one counts as used until the next reset
+            UsedBeforeChunk += Chunk.Size;
+            ++CurrentChunk;
+            Offset = 0;
+
+            if (Chunks.IsValidIndex(CurrentChunk))
+            {
+                continue;
+            }
+        }
+
+        FChunk NewChunk;
+        NewChunk.Size = FMath::Max(ChunkSize, Size + Alignment);
+        NewChunk.Data = static_cast<uint8*>(FMemory::Malloc(NewChunk.Size, Alignment));
+        Chunks.Add(NewChunk);
+
+        BytesReserved += NewChunk.Size;
+        ++ChunkAllocations;
+        CurrentChunk = Chunks.Num() - 1;
+    }
+}
+
+void FProcessorArena::PopToMark(const FMark& Mark)
+{
+    check(Mark.ChunkIndex <= CurrentChunk);
+
+    CurrentChunk = Mark.ChunkIndex;
+    Offset = Mark.Offset;
+    UsedBeforeChunk = Mark.UsedBeforeChunk;
+}
+
+void FProcessorArena::Trim()
+{
+    const int32 FirstUnused = (Offset > 0 || CurrentChunk > 0) ? CurrentChunk + 1 : 0;
+    for (int32 Index = Chunks.Num() - 1; Index >= FirstUnused; --Index)
+    {
+        BytesReserved -= Chunks[Index].Size;
+        FMemory::Free(Chunks[Index].Data);
+        Chunks.RemoveAt(Index);
+    }
+}
+
+void FProcessorArena::ResetStats()
+{
+    PeakBytesUsed = GetBytesUsed();
+    ChunkAllocations = 0;
+    AllocationCount = 0;
+}
+
+FProcessorArena* FProcessorArena::GetCurrent()
+{
+    return ProcessorArena::CurrentArena;
+}
+
+FProcessorArena& FProcessorArena::GetThreadArena()
+{
+    static thread_local FProcessorArena ThreadArena;
+    return ThreadArena;
+}
+
+FProcessorArenaScope::FProcessorArenaScope(FProcessorArena& InArena)
+    : Arena(InArena)
+    , PreviousArena(ProcessorArena::CurrentArena)
+    , Mark(InArena.GetMark())
+{
+    ProcessorArena::CurrentArena = &Arena;
+}
+
+FProcessorArenaScope::~FProcessorArenaScope()
+{
+    Arena.PopToMark(Mark);
+    ProcessorArena::CurrentArena = PreviousArena;
+}
@@ -0,0 +1,503 @@
+#include "TwinPluginFramework/Processing/SensorKernels.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Core/Logs.h"
+
+namespace TwinKernels
+{
+    // Partial sums are flushed to double every block so long buffers keep their precision
+    static constexpr int32 SumBlockSize = 1024;
+
+    void ScaleOffset(TArrayView<const float> In, TArrayView<float> Out, float Scale, float Offset)
+    {
+        check(Out.Num() >= In.Num());
+        const int32 Num = In.Num();
+        const VectorRegister4Float VScale = VectorSetFloat1(Scale);
+        const VectorRegister4Float VOffset = VectorSetFloat1(Offset);
+
+        int32 Index = 0;
+        for (; Index + 4 <= Num; Index += 4)
+        {
+            VectorStore(VectorMultiplyAdd(VectorLoad(&In[Index]), VScale, VOffset), &Out[Index]);
+        }
+        for (; Index < Num; ++Index)
+        {
+            Out[Index] = In[Index] * Scale + Offset;
+        }
+    }
+
+    void Clamp(TArrayView<const float> In, TArrayView<float> Out, float MinValue, float MaxValue)
+    {
+        check(Out.Num() >= In.Num());
+        const int32 Num = In.Num();
+        const VectorRegister4Float VMin = VectorSetFloat1(MinValue);
+        const VectorRegister4Float VMax = VectorSetFloat1(MaxValue);
+
+        int32 Index = 0;
+        for (; Index + 4 <= Num; Index += 4)
+        {
+            VectorStore(VectorMin(VectorMax(VectorLoad(&In[Index]), VMin), VMax), &Out[Index]);
+        }
+        for (; Index < Num; ++Index)
+        {
+            Out[Index] = FMath::Clamp(In[Index], MinValue, MaxValue);
+        }
+    }
+
+    void ThresholdMask(TArrayView<const float> In, TArrayView<float> Out, float Threshold)
+    {
+        check(Out.Num() >= In.Num());
+        const int32 Num = In.Num();
+        const VectorRegister4Float VThreshold = VectorSetFloat1(Threshold);
+        const VectorRegister4Float VOne = VectorOneFloat();
+        const VectorRegister4Float VZero = VectorZeroFloat();
+
+        int32 Index = 0;
+        for (; Index + 4 <= Num; Index += 4)
+        {
+            const VectorRegister4Float Mask = VectorCompareGT(VectorLoad(&In[Index]), VThreshold);
+            VectorStore(VectorSelect(Mask, VOne, VZero), &Out[Index]);
+        }
+        for (; Index < Num; ++Index)
+        {
+            Out[Index] = In[Index] > Threshold ? 1.0f : 0.0f;
+        }
+    }
+
+    int32 CountAbove(TArrayView<const float> In, float Threshold)
+    {
+        const int32 Num = In.Num();
+        const VectorRegister4Float VThreshold = VectorSetFloat1(Threshold);
+
+        int32 Count = 0;
+        int32 Index = 0;
+        for (; Index + 4 <= Num; Index += 4)
+        {
+            const int32 Mask = VectorMaskBits(VectorCompareGT(VectorLoad(&In[Index]), VThreshold));
+            Count += FMath::CountBits(static_cast<uint64>(Mask));
+        }
+        for (; Index < Num; ++Index)
+        {
+            Count += In[Index] > Threshold ? 1 : 0;
+        }
+        return Count;
+    }
+
+    void MovingAverage(TArrayView<const float> In, TArrayView<float> Out, int32 Window)
+    {
+        // A running sum is already O(n) with one add and one subtract per sample; the
+        // loop-carried dependency leaves nothing for 4-wide lanes to win here.
+        check(Out.Num() >= In.Num());
+        check(Out.GetData() != In.GetData());
+        Window = FMath::Max(Window, 1);
+
+        double RunningSum = 0.0;
+        for (int32 Index = 0; Index < In.Num(); ++Index)
+        {
+            RunningSum += In[Index];
+            if (Index >= Window)
+            {
+                RunningSum -= In[Index - Window];
+            }
+            Out[Index] = static_cast<float>(RunningSum / FMath::Min(Index + 1, Window));
+        }
+    }
+
+    void Derivative(TArrayView<const float> In, TArrayView<float> Out, float SampleInterval)
+    {
+        check(Out.Num() >= In.Num());
+        check(Out.GetData() != In.GetData());
+        const int32 Num = In.Num();
+        if (Num < 2)
+        {
+            if (Num == 1)
+            {
+                Out[0] = 0.0f;
+            }
+            return;
+        }
+
+        const float InvInterval = 1.0f / FMath::Max(SampleInterval, UE_SMALL_NUMBER);
+        const VectorRegister4Float VInvInterval = VectorSetFloat1(InvInterval);
+
+        int32 Index = 0;
+        for (; Index + 5 <= Num; Index += 4)
+        {
+            const VectorRegister4Float Current = VectorLoad(&In[Index]);
+            const VectorRegister4Float Next = VectorLoad(&In[Index + 1]);
+            VectorStore(VectorMultiply(VectorSubtract(Next, Current), VInvInterval), &Out[Index]);
+        }
+        for (; Index < Num - 1; ++Index)
+        {
+            Out[Index] = (In[Index + 1] - In[Index]) * InvInterval;
+        }
+        Out[Num - 1] = Out[Num - 2];
+    }
+
+    FKernelStats ComputeStats(TArrayView<const float> In)
+    {
+        FKernelStats Stats;
+        const int32 Num = In.Num();
+        if (Num == 0)
+        {
+            return Stats;
+        }
+
+        VectorRegister4Float VMin = VectorSetFloat1(In[0]);
+        VectorRegister4Float VMax = VMin;
+        double Sum = 0.0;
+
+        int32 Index = 0;
+        while (Index + 4 <= Num)
+        {
+            const int32 BlockEnd = FMath::Min(Index + SumBlockSize, Num);
+            VectorRegister4Float VSum = VectorZeroFloat();
+            for (; Index + 4 <= BlockEnd; Index += 4)
+            {
+                const VectorRegister4Float Value = VectorLoad(&In[Index]);
+                VMin = VectorMin(VMin, Value);
+                VMax = VectorMax(VMax, Value);
+                VSum = VectorAdd(VSum, Value);
+            }
+
+            alignas(16) float Lanes[4];
+            VectorStoreAligned(VSum, Lanes);
+            Sum += static_cast<double>(Lanes[0]) + Lanes[1] + Lanes[2] + Lanes[3];
+        }
+
+        alignas(16) float MinLanes[4];
+        alignas(16) float MaxLanes[4];
+        VectorStoreAligned(VMin, MinLanes);
+        VectorStoreAligned(VMax, MaxLanes);
+        Stats.Min = FMath::Min(FMath::Min(MinLanes[0], MinLanes[1]), FMath::Min(MinLanes[2], MinLanes[3]));
+        Stats.Max = FMath::Max(FMath::Max(MaxLanes[0], MaxLanes[1]), FMath::Max(MaxLanes[2], MaxLanes[3]));
+
+        for (; Index < Num; ++Index)
+        {
+            Stats.Min = FMath::Min(Stats.Min, In[Index]);
+            Stats.Max = FMath::Max(Stats.Max, In[Index]);
+            Sum += In[Index];
+        }
+
+        Stats.Count = Num;
+        Stats.Mean = Sum / Num;
+        return Stats;
+    }
+
+    void ResampleLinear(TArrayView<const float> In, TArrayView<float> Out)
+    {
+        // Gather-bound, kept scalar
+        check(Out.GetData() != In.GetData());
+        const int32 NumIn = In.Num();
+        const int32 NumOut = Out.Num();
+        if (NumOut == 0)
+        {
+            return;
+        }
+        if (NumIn == 0)
+        {
+            FMemory::Memzero(Out.GetData(), NumOut * sizeof(float));
+            return;
+        }
+        if (NumIn == 1 || NumOut == 1)
+        {
+            for (float& Value : Out)
+            {
+                Value = In[0];
+            }
+            return;
+        }
+
+        const double Step = static_cast<double>(NumIn - 1) / static_cast<double>(NumOut - 1);
+        for (int32 Index = 0; Index < NumOut; ++Index)
+        {
+            const double Position = Index * Step;
+            const int32 Lower = FMath::Min(static_cast<int32>(Position), NumIn - 2);
+            const float Alpha = static_cast<float>(Position - Lower);
+            Out[Index] = FMath::Lerp(In[Lower], In[Lower + 1], Alpha);
+        }
+    }
+
+    namespace Scalar
+    {
+        void ScaleOffset(TArrayView<const float> In, TArrayView<float> Out, float Scale, float Offset)
+        {
+            for (int32 Index = 0; Index < In.Num(); ++Index)
+            {
+                Out[Index] = In[Index] * Scale + Offset;
+            }
+        }
+
+        void Clamp(TArrayView<const float> In, TArrayView<float> Out, float MinValue, float MaxValue)
+        {
+            for (int32 Index = 0; Index < In.Num(); ++Index)
+            {
+                Out[Index] = FMath::Clamp(In[Index], MinValue, MaxValue);
+            }
+        }
+
+        void ThresholdMask(TArrayView<const float> In, TArrayView<float> Out, float Threshold)
+        {
+            for (int32 Index = 0; Index < In.Num(); ++Index)
+            {
+                Out[Index] = In[Index] > Threshold ? 1.0f : 0.0f;
+            }
+        }
+
+        int32 CountAbove(TArrayView<const float> In, float Threshold)
+        {
+            int32 Count = 0;
+            for (const float Value : In)
+            {
+                Count += Value > Threshold ? 1 : 0;
+            }
+            return Count;
+        }
+
+        void MovingAverage(TArrayView<const float> In, TArrayView<float> Out, int32 Window)
+        {
+            // Sums every window from scratch, the definition the running sum has to match
+            Window = FMath::Max(Window, 1);
+            for (int32 Index = 0; Index < In.Num(); ++Index)
+            {
+                const int32 First = FMath::Max(Index - Window + 1, 0);
+                double Sum = 0.0;
+                for (int32 Sample = First; Sample <= Index; ++Sample)
+                {
+                    Sum += In[Sample];
+                }
+                Out[Index] = static_cast<float>(Sum / (Index - First + 1));
+            }
+        }
+
+        void Derivative(TArrayView<const float> In, TArrayView<float> Out, float SampleInterval)
+        {
+            const int32 Num = In.Num();
+            const float InvInterval = 1.0f / FMath::Max(SampleInterval, UE_SMALL_NUMBER);
+            for (int32 Index = 0; Index < Num - 1; ++Index)
+            {
+                Out[Index] = (In[Index + 1] - In[Index]) * InvInterval;
+            }
+            if (Num >= 2)
+            {
+                Out[Num - 1] = Out[Num - 2];
+            }
+            else if (Num == 1)
+            {
+                Out[0] = 0.0f;
+            }
+        }
+
+        FKernelStats ComputeStats(TArrayView<const float> In)
+        {
+            FKernelStats Stats;
+            if (In.IsEmpty())
+            {
+                return Stats;
+            }
+
+            double Sum = 0.0;
+            Stats.Min = In[0];
+            Stats.Max = In[0];
+            for (const float Value : In)
+            {
+                Stats.Min = FMath::Min(Stats.Min, Value);
+                Stats.Max = FMath::Max(Stats.Max, Value);
+                Sum += Value;
+            }
+
+            Stats.Count = In.Num();
+            Stats.Mean = Sum / In.Num();
+            return Stats;
+        }
+
+        void ResampleLinear(TArrayView<const float> In, TArrayView<float> Out)
+        {
+            const int32 NumIn = In.Num();
+            const int32 NumOut = Out.Num();
+            for (int32 Index = 0; Index < NumOut; ++Index)
+            {
+                if (NumIn == 0)
+                {
+                    Out[Index] = 0.0f;
+                    continue;
+                }
+
+                // Position of the output sample on the input, computed per sample instead of stepped
+                const double Position = NumOut > 1 ? static_cast<double>(Index) * (NumIn - 1) / (NumOut - 1) : 0.0;
+                const int32 Lower = FMath::FloorToInt32(Position);
+                const int32 Upper = FMath::Min(Lower + 1, NumIn - 1);
+                Out[Index] = FMath::Lerp(In[Lower], In[Upper], static_cast<float>(Position - Lower));
+            }
+        }
+    }
+
+    static bool NearlyEqualBuffers(TArrayView<const float> A, TArrayView<const float> B)
+    {
+        for (int32 Index = 0; Index < A.Num(); ++Index)
+        {
+            if (!FMath::IsNearlyEqual(A[Index], B[Index], 1e-3f * FMath::Max(1.0f, FMath::Abs(A[Index]))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void RunBenchmark(const TArray<FString>& Args)
+    {
+        const int32 NumSamples = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 16) : 1 << 20;
+        const int32 Iterations = 20;
+
+        FRandomStream Random(1234);
+        TArray<float> Input;
+        Input.SetNumUninitialized(NumSamples);
+        for (float& Value : Input)
+        {
+            Value = Random.FRandRange(-100.0f, 100.0f);
+        }
+
+        TArray<float> VectorOut;
+        TArray<float> ScalarOut;
+        VectorOut.SetNumUninitialized(NumSamples);
+        ScalarOut.SetNumUninitialized(NumSamples);
+
+        const auto Time = [Iterations](TFunctionRef<void()> Body)
+        {
+            const double Start = FPlatformTime::Seconds();
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                Body();
+            }
+            return (FPlatformTime::Seconds() - Start) * 1000.0 / Iterations;
+        };
+
+        const auto Report = [NumSamples](const TCHAR* Name, double VectorMs, double ScalarMs, bool bMatches)
+        {
+            UE_LOG(LogMode, Log, TEXT("  %-14s vector %7.3f ms  scalar %7.3f ms  x%.2f  %s"),
+                Name, VectorMs, ScalarMs, VectorMs > 0.0 ? ScalarMs / VectorMs : 0.0, bMatches ? TEXT("OK") : TEXT("MISMATCH"));
+        };
+
+        UE_LOG(LogMode, Log, TEXT("=== TWIN KERNEL BENCHMARK (%d samples, %d iterations) ==="), NumSamples, Iterations);
+
+        {
+            const double V = Time([&]() { ScaleOffset(Input, VectorOut, 1.8f, 32.0f); });
+            const double S = Time([&]() { Scalar::ScaleOffset(Input, ScalarOut, 1.8f, 32.0f); });
+            Report(TEXT("ScaleOffset"), V, S, NearlyEqualBuffers(VectorOut, ScalarOut));
+        }
+        {
+            const double V = Time([&]() { Clamp(Input, VectorOut, -10.0f, 10.0f); });
+            const double S = Time([&]() { Scalar::Clamp(Input, ScalarOut, -10.0f, 10.0f); });
+            Report(TEXT("Clamp"), V, S, NearlyEqualBuffers(VectorOut, ScalarOut));
+        }
+        {
+            const double V = Time([&]() { ThresholdMask(Input, VectorOut, 25.0f); });
+            const double S = Time([&]() { Scalar::ThresholdMask(Input, ScalarOut, 25.0f); });
+            Report(TEXT("ThresholdMask"), V, S, NearlyEqualBuffers(VectorOut, ScalarOut));
+        }
+        {
+            int32 VectorCount = 0;
+            int32 ScalarCount = 0;
+            const double V = Time([&]() { VectorCount = CountAbove(Input, 25.0f); });
+            const double S = Time([&]() { ScalarCount = Scalar::CountAbove(Input, 25.0f); });
+            Report(TEXT("CountAbove"), V, S, VectorCount == ScalarCount);
+        }
+        {
+            const double V = Time([&]() { MovingAverage(Input, VectorOut, 8); });
+            const double S = Time([&]() { Scalar::MovingAverage(Input, ScalarOut, 8); });
+            Report(TEXT("MovingAverage"), V, S, NearlyEqualBuffers(VectorOut, ScalarOut));
+        }
+        {
+            const double V = Time([&]() { Derivative(Input, VectorOut, 0.01f); });
+            const double S = Time([&]() { Scalar::Derivative(Input, ScalarOut, 0.01f); });
+            Report(TEXT("Derivative"), V, S, NearlyEqualBuffers(VectorOut, ScalarOut));
+        }
+        {
+            FKernelStats VectorStats;
+            FKernelStats ScalarStats;
+            const double V = Time([&]() { VectorStats = ComputeStats(Input); });
+            const double S = Time([&]() { ScalarStats = Scalar::ComputeStats(Input); });
+            const bool bMatches = VectorStats.Min == ScalarStats.Min && VectorStats.Max == ScalarStats.Max
+                && FMath::IsNearlyEqual(VectorStats.Mean, ScalarStats.Mean, 1e-3);
+            Report(TEXT("ComputeStats"), V, S, bMatches);
+        }
+        {
+            // Upsample by 1.5x into fresh buffers, the shared ones are sized for the input
+            TArray<float> VectorResampled;
+            TArray<float> ScalarResampled;
+            VectorResampled.SetNumUninitialized(NumSamples + NumSamples / 2);
+            ScalarResampled.SetNumUninitialized(NumSamples + NumSamples / 2);
+            const double V = Time([&]() { ResampleLinear(Input, VectorResampled); });
+            const double S = Time([&]() { Scalar::ResampleLinear(Input, ScalarResampled); });
+            Report(TEXT("ResampleLinear"), V, S, NearlyEqualBuffers(VectorResampled, ScalarResampled));
+        }
+
+        UE_LOG(LogMode, Log, TEXT("================================="));
+    }
+
+    static FAutoConsoleCommand BenchmarkCommand(
+        TEXT("Twin.Kernels.Bench"),
+        TEXT("Benchmarks the vectorized sensor kernels against their scalar reference. Usage: Twin.Kernels.Bench [NumSamples]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmark));
+}
+
+TArray<float> UTwinKernelLibrary::ScaleOffset(const TArray<float>& Samples, float Scale, float Offset)
+{
+    TArray<float> Result;
+    Result.SetNumUninitialized(Samples.Num());
+    TwinKernels::ScaleOffset(Samples, Result, Scale, Offset);
+    return Result;
+}
+
+TArray<float> UTwinKernelLibrary::ClampSamples(const TArray<float>& Samples, float MinValue, float MaxValue)
+{
+    TArray<float> Result;
+    Result.SetNumUninitialized(Samples.Num());
+    TwinKernels::Clamp(Samples, Result, MinValue, MaxValue);
+    return Result;
+}
+
+TArray<float> UTwinKernelLibrary::ThresholdMask(const TArray<float>& Samples, float Threshold)
+{
+    TArray<float> Result;
+    Result.SetNumUninitialized(Samples.Num());
+    TwinKernels::ThresholdMask(Samples, Result, Threshold);
+    return Result;
+}
+
+int32 UTwinKernelLibrary::CountAbove(const TArray<float>& Samples, float Threshold)
+{
+    return TwinKernels::CountAbove(Samples, Threshold);
+}
+
+TArray<float> UTwinKernelLibrary::MovingAverage(const TArray<float>& Samples, int32 Window)
+{
+    TArray<float> Result;
+    Result.SetNumUninitialized(Samples.Num());
+    TwinKernels::MovingAverage(Samples, Result, Window);
+    return Result;
+}
+
+TArray<float> UTwinKernelLibrary::Derivative(const TArray<float>& Samples, float SampleInterval)
+{
+    TArray<float> Result;
+    Result.SetNumUninitialized(Samples.Num());
+    TwinKernels::Derivative(Samples, Result, SampleInterval);
+    return Result;
+}
+
+void UTwinKernelLibrary::ComputeStats(const TArray<float>& Samples, float& Min, float& Max, float& Mean)
+{
+    const TwinKernels::FKernelStats Stats = TwinKernels::ComputeStats(Samples);
+    Min = Stats.Min;
+    Max = Stats.Max;
+    Mean = static_cast<float>(Stats.Mean);
+}
+
+TArray<float> UTwinKernelLibrary::ResampleLinear(const TArray<float>& Samples, int32 NumOutputSamples)
+{
+    TArray<float> Result;
+    Result.SetNumUninitialized(FMath::Max(NumOutputSamples, 0));
+    TwinKernels::ResampleLinear(Samples, Result);
+    return Result;
+}
@@ -3,6 +3,7 @@
 #include "TwinPluginFramework/Core/TwinPluginManager.h"
 #include "Subsystems/UIManagerSubsystem.h"
 #include "Subsystems/ModeManagerSubsystem.h"
+#include "Subsystems/EventBusSubsystem.h"
 #include "Blueprint/UserWidget.h"
 #include "Core/Logs.h"
 
@@ -89,6 +90,10 @@ void UBasicToolTemplate::ShutdownTool_Implementation()
     // Clean up cached widget
     if (CachedWidget)
     {
+        if (UUIManagerSubsystem* UIManager = GetUIManager())
+        {
+            UIManager->RemoveWidget(CachedWidget);
+        }
         CachedWidget->RemoveFromParent();
         CachedWidget = nullptr;
     }
@@ -125,9 +130,10 @@ UUserWidget* UBasicToolTemplate::CreateToolWidget_Implementation()
         return CachedWidget;
     }
 
-    if (ToolWidgetClass.IsValid())
+    if (!ToolWidgetClass.IsNull())
     {
-        if (UClass* WidgetClass = ToolWidgetClass.LoadSynchronous())
+        UModeManagerSubsystem* ModeManager = GetModeManager();
+        if (UClass* WidgetClass = ModeManager ? ModeManager->LoadClassForMode(ToolWidgetClass) : ToolWidgetClass.LoadSynchronous())
         {
             CachedWidget = CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
             if (CachedWidget)
@@ -140,6 +146,18 @@ UUserWidget* UBasicToolTemplate::CreateToolWidget_Implementation()
     return CachedWidget;
 }
 
+void UBasicToolTemplate::GetPrewarmAssets(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths) const
+{
+    if (!ToolWidgetClass.IsNull())
+    {
+        OutPaths.AddUnique(ToolWidgetClass.ToSoftObjectPath());
+    }
+    if (!ToolMetadata.Icon.IsNull())
+    {
+        OutPaths.AddUnique(ToolMetadata.Icon.ToSoftObjectPath());
+    }
+}
+
 void UBasicToolTemplate::OnModeChanged_Implementation(EAppMode NewMode)
 {
     CurrentMode = NewMode;
@@ -156,14 +174,39 @@ void UBasicToolTemplate::OnModeChanged_Implementation(EAppMode NewMode)
 
 void UBasicToolTemplate::BroadcastProgress(float Progress, const FString& Message)
 {
+    UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this);
+    if (EventBus && EventBus->HasListeners<FToolProgressEvent>())
+    {
+        FToolProgressEvent Event;
+        Event.ToolTopic = ToolTopic;
+        Event.Tool = this;
+        Event.Progress = Progress;
+        Event.Message = Message;
+        EventBus->Publish(Event);
+    }
     OnToolProgress.Broadcast(this, Progress, Message);
 }
 
 void UBasicToolTemplate::BroadcastStateChanged(bool bActive)
 {
+    UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this);
+    if (EventBus && EventBus->HasListeners<FToolStateChangedEvent>())
+    {
+        FToolStateChangedEvent Event;
+        Event.ToolTopic = ToolTopic;
+        Event.Tool = this;
+        Event.bActive = bActive;
+        EventBus->Publish(Event);
+    }
     OnToolStateChanged.Broadcast(this, bActive);
 }
 
+void UBasicToolTemplate::SetToolID(const FString& InToolID)
+{
+    ToolID = InToolID;
+    ToolTopic = ToolID.IsEmpty() ? NAME_None : FName(*ToolID);
+}
+
 UTwinPluginManager* UBasicToolTemplate::GetPluginManager() const
 {
     return UGlobalServices::GetPluginManager(this);
@@ -2,6 +2,19 @@
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "Core/Logs.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace DataProcessorCheckpoint
+{
+    static constexpr uint32 Magic = 0x54574350; // 'TWCP'
+    static constexpr uint32 Version = 1;
+}
 
 UDataProcessorTemplate::UDataProcessorTemplate()
 {
@@ -16,7 +29,7 @@ UDataProcessorTemplate::UDataProcessorTemplate()
     ToolMetadata.Category = EToolCategory::Analysis;
 }
 
-void UDataProcessorTemplate::StartProcessing()
+void UDataProcessorTemplate::StartProcessing(bool bResumeFromCheckpoint)
 {
     if (bIsProcessing)
     {
@@ -30,7 +43,7 @@ void UDataProcessorTemplate::StartProcessing()
         return;
     }
 
-    InternalStartProcessing();
+    InternalStartProcessing(bResumeFromCheckpoint);
 }
 
 void UDataProcessorTemplate::CancelProcessing()
@@ -48,6 +61,12 @@ void UDataProcessorTemplate::CancelProcessing()
         GetWorld()->GetTimerManager().ClearTimer(ProcessingTimer);
     }
 
+    // Keep the work done so far so the job can be resumed later
+    if (bEnableCheckpoints && CurrentBatch > 0)
+    {
+        WriteCheckpoint(true);
+    }
+
     bIsProcessing = false;
     bIsPaused = false;
     CurrentProgress = 0.0f;
@@ -104,12 +123,19 @@ void UDataProcessorTemplate::CompleteProcessing(bool bSuccess, const FString& Re
     InternalCompleteProcessing(bSuccess, Result);
 }
 
-void UDataProcessorTemplate::InternalStartProcessing()
+void UDataProcessorTemplate::InternalStartProcessing(bool bResumeFromCheckpoint)
 {
     bIsProcessing = true;
     bIsPaused = false;
     CurrentProgress = 0.0f;
     CurrentBatch = 0;
+    BatchesSinceCheckpoint = 0;
+
+    if (!BatchArena)
+    {
+        BatchArena = MakeUnique<FProcessorArena>(static_cast<SIZE_T>(ArenaChunkSizeKB) * 1024);
+    }
+    BatchArena->ResetStats();
 
     // Get total number of batches from Blueprint implementation
     TotalBatches = GetTotalBatches();
@@ -127,6 +153,22 @@ void UDataProcessorTemplate::InternalStartProcessing()
     // Initialize processing in Blueprint
     InitializeProcessing();
 
+    if (bResumeFromCheckpoint)
+    {
+        int32 SavedBatch = 0;
+        TArray<uint8> SavedState;
+        if (ReadCheckpoint(SavedBatch, SavedState) && LoadCheckpointState(SavedState))
+        {
+            CurrentBatch = SavedBatch;
+            UE_LOG(LogMode, Log, TEXT("Resuming %s from checkpoint at batch %d/%d"),
+                *ToolMetadata.ToolName, CurrentBatch, TotalBatches);
+        }
+        else
+        {
+            UE_LOG(LogMode, Warning, TEXT("No usable checkpoint for %s, starting from batch 0"), *ToolMetadata.ToolName);
+        }
+    }
+
     // Start processing timer
     if (GetWorld())
     {
@@ -139,7 +181,14 @@ void UDataProcessorTemplate::InternalStartProcessing()
         );
     }
 
-    UpdateProgress(0.0f, TEXT("Processing started"));
+    if (CurrentBatch > 0)
+    {
+        UpdateProgress(static_cast<float>(CurrentBatch) / static_cast<float>(TotalBatches), TEXT("Processing resumed"));
+    }
+    else
+    {
+        UpdateProgress(0.0f, TEXT("Processing started"));
+    }
 }
 
 void UDataProcessorTemplate::ProcessNextBatch()
@@ -156,11 +205,19 @@ void UDataProcessorTemplate::ProcessNextBatch()
         return;
     }
 
-    // Process current batch in Blueprint
-    ProcessDataBatch(CurrentBatch);
+    // Process current batch (Blueprint or native override), scratch memory is released in bulk when the scope ends
+    {
+        FProcessorArenaScope ArenaScope(*BatchArena);
+        ProcessDataBatch(CurrentBatch);
+    }
 
     CurrentBatch++;
 
+    if (bEnableCheckpoints && ++BatchesSinceCheckpoint >= FMath::Max(CheckpointInterval, 1))
+    {
+        WriteCheckpoint(false);
+    }
+
     // Update progress
     float Progress = static_cast<float>(CurrentBatch) / static_cast<float>(TotalBatches);
     FString Status = FString::Printf(TEXT("Processing batch %d/%d"), CurrentBatch, TotalBatches);
@@ -188,11 +245,228 @@ void UDataProcessorTemplate::InternalCompleteProcessing(bool bSuccess, const FSt
         CurrentProgress = 1.0f;
         // Finalize processing in Blueprint
         FinalizeProcessing();
+
+        if (bEnableCheckpoints)
+        {
+            DeleteCheckpoint();
+        }
     }
 
     UE_LOG(LogMode, Log, TEXT("Processing completed for: %s - Success: %s"),
         *ToolMetadata.ToolName, bSuccess ? TEXT("Yes") : TEXT("No"));
 
+    if (BatchArena && BatchArena->GetAllocationCount() > 0)
+    {
+        UE_LOG(LogMode, Log, TEXT("Scratch arena for %s: peak %.1f KB, %lld allocations served by %d chunk allocations"),
+            *ToolMetadata.ToolName, BatchArena->GetPeakBytesUsed() / 1024.0, BatchArena->GetAllocationCount(), BatchArena->GetChunkAllocations());
+    }
+
     OnDataProcessingComplete.Broadcast(bSuccess, Result);
     BroadcastProgress(CurrentProgress, bSuccess ? TEXT("Completed") : TEXT("Failed"));
-}
\ No newline at end of file
+}
+
+int64 UDataProcessorTemplate::GetArenaPeakBytes() const
+{
+    return BatchArena ? static_cast<int64>(BatchArena->GetPeakBytesUsed()) : 0;
+}
+
+void UDataProcessorTemplate::BeginDestroy()
+{
+    WaitForPendingCheckpoint();
+    Super::BeginDestroy();
+}
+
+bool UDataProcessorTemplate::ProducePipelinePackets(FDataPipelineEmitter& Emitter)
+{
+    UE_LOG(LogMode, Error, TEXT("%s does not implement ProducePipelinePackets and cannot be a pipeline source"), *ToolMetadata.ToolName);
+    return false;
+}
+
+bool UDataProcessorTemplate::ProcessPipelinePacket(FDataPipelinePacket&& Packet, FDataPipelineEmitter& Emitter)
+{
+    return Emitter.Emit(MoveTemp(Packet));
+}
+
+bool UDataProcessorTemplate::FlushPipelineStage(FDataPipelineEmitter& Emitter)
+{
+    return true;
+}
+
+void UDataProcessorTemplate::InitializeProcessing_Implementation()
+{
+}
+
+void UDataProcessorTemplate::ProcessDataBatch_Implementation(int32 BatchIndex)
+{
+}
+
+void UDataProcessorTemplate::FinalizeProcessing_Implementation()
+{
+}
+
+int32 UDataProcessorTemplate::GetTotalBatches_Implementation() const
+{
+    return 0;
+}
+
+void UDataProcessorTemplate::SaveCheckpointState_Implementation(TArray<uint8>& OutState)
+{
+    // Default processors carry no state beyond the batch index
+    OutState.Reset();
+}
+
+bool UDataProcessorTemplate::LoadCheckpointState_Implementation(const TArray<uint8>& State)
+{
+    return true;
+}
+
+FString UDataProcessorTemplate::GetCheckpointFilePath() const
+{
+    // Keyed by an identity that survives a restart, the object's own name is numbered per session
+    FString Name = CheckpointName;
+    if (Name.IsEmpty())
+    {
+        Name = GetToolID().IsEmpty() ? GetClass()->GetName() + TEXT("_") + ToolMetadata.ToolName : GetToolID();
+    }
+    Name = FPaths::MakeValidFileName(Name, TEXT('_'));
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Checkpoints"), Name + TEXT(".twckpt"));
+}
+
+bool UDataProcessorTemplate::HasCheckpoint() const
+{
+    return IFileManager::Get().FileExists(*GetCheckpointFilePath());
+}
+
+void UDataProcessorTemplate::DeleteCheckpoint()
+{
+    WaitForPendingCheckpoint();
+    IFileManager::Get().Delete(*GetCheckpointFilePath(), false, false, true);
+}
+
+void UDataProcessorTemplate::WaitForPendingCheckpoint()
+{
+    if (PendingCheckpointWrite.IsValid())
+    {
+        PendingCheckpointWrite.Wait();
+        PendingCheckpointWrite.Reset();
+    }
+}
+
+void UDataProcessorTemplate::WriteCheckpoint(bool bForce)
+{
+    if (PendingCheckpointWrite.IsValid() && !PendingCheckpointWrite.IsReady())
+    {
+        // Never queue up writes behind a slow disk, the next interval will catch up
+        if (!bForce)
+        {
+            return;
+        }
+        PendingCheckpointWrite.Wait();
+    }
+
+    BatchesSinceCheckpoint = 0;
+
+    TArray<uint8> State;
+    SaveCheckpointState(State);
+
+    const int32 Batch = CurrentBatch;
+    const int32 Total = TotalBatches;
+    const FString FilePath = GetCheckpointFilePath();
+    const FString ToolName = ToolMetadata.ToolName;
+
+    // Compression and file I/O run off the game thread
+    PendingCheckpointWrite = Async(EAsyncExecution::ThreadPool, [State = MoveTemp(State), Batch, Total, FilePath, ToolName]() mutable -> bool
+    {
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, State.Num());
+        TArray<uint8> Compressed;
+        Compressed.SetNumUninitialized(CompressedSize);
+        if (State.Num() == 0 || !FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, State.GetData(), State.Num()))
+        {
+            CompressedSize = 0;
+        }
+        Compressed.SetNum(CompressedSize, EAllowShrinking::No);
+
+        uint32 Magic = DataProcessorCheckpoint::Magic;
+        uint32 Version = DataProcessorCheckpoint::Version;
+        int32 BatchIndex = Batch;
+        int32 TotalCount = Total;
+        int32 RawSize = CompressedSize > 0 ? State.Num() : 0;
+
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer(Bytes);
+        Writer << Magic << Version << TotalCount << BatchIndex << RawSize;
+        if (RawSize > 0)
+        {
+            Writer << Compressed;
+        }
+        else
+        {
+            Writer << State;
+        }
+
+        // Write to a temp file first so a crash mid-write never corrupts the last good checkpoint
+        const FString TempPath = FilePath + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+        {
+            UE_LOG(LogMode, Error, TEXT("Failed to write checkpoint for %s: %s"), *ToolName, *FilePath);
+            return false;
+        }
+
+        UE_LOG(LogMode, Verbose, TEXT("Checkpoint written for %s at batch %d/%d (%d bytes)"), *ToolName, Batch, Total, Bytes.Num());
+        return true;
+    });
+}
+
+bool UDataProcessorTemplate::ReadCheckpoint(int32& OutBatch, TArray<uint8>& OutState) const
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *GetCheckpointFilePath(), FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    int32 SavedTotal = 0;
+    int32 SavedBatch = 0;
+    int32 RawSize = 0;
+    Reader << Magic << Version << SavedTotal << SavedBatch << RawSize;
+
+    if (Reader.IsError() || Magic != DataProcessorCheckpoint::Magic || Version != DataProcessorCheckpoint::Version)
+    {
+        UE_LOG(LogMode, Warning, TEXT("Ignoring invalid checkpoint for %s"), *ToolMetadata.ToolName);
+        return false;
+    }
+
+    if (SavedTotal != TotalBatches || SavedBatch < 0 || SavedBatch > TotalBatches)
+    {
+        UE_LOG(LogMode, Warning, TEXT("Checkpoint for %s was taken with %d batches, job now has %d"),
+            *ToolMetadata.ToolName, SavedTotal, TotalBatches);
+        return false;
+    }
+
+    TArray<uint8> Payload;
+    Reader << Payload;
+    if (Reader.IsError())
+    {
+        return false;
+    }
+
+    if (RawSize > 0)
+    {
+        OutState.SetNumUninitialized(RawSize);
+        if (!FCompression::UncompressMemory(NAME_Zlib, OutState.GetData(), RawSize, Payload.GetData(), Payload.Num()))
+        {
+            UE_LOG(LogMode, Warning, TEXT("Failed to decompress checkpoint for %s"), *ToolMetadata.ToolName);
+            return false;
+        }
+    }
+    else
+    {
+        OutState = MoveTemp(Payload);
+    }
+
+    OutBatch = SavedBatch;
+    return true;
+}
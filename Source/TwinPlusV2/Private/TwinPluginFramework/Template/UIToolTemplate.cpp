@@ -1,6 +1,7 @@
 #include "TwinPluginFramework/Template/UIToolTemplate.h"
 #include "Subsystems/GlobalServices.h"
 #include "Subsystems/UIManagerSubsystem.h"
+#include "Subsystems/ModeManagerSubsystem.h"
 #include "Blueprint/UserWidget.h"
 #include "Core/Logs.h"
 
@@ -29,6 +30,8 @@ void UUIToolTemplate::ActivateTool_Implementation()
 
 void UUIToolTemplate::DeactivateTool_Implementation()
 {
+    bShowPending = false;
+
     if (bUIVisible)
     {
         HideToolUI();
@@ -39,15 +42,22 @@ void UUIToolTemplate::DeactivateTool_Implementation()
 
 UUserWidget* UUIToolTemplate::CreateToolWidget_Implementation()
 {
-    // Check if we have mode-specific widgets
-    if (ModeSpecificWidgets.Contains(CurrentMode))
+    // Check if we have mode-specific widgets, kept so hiding and showing again reuses them
+    if (const TSoftClassPtr<UUserWidget>* ModeWidget = ModeSpecificWidgets.Find(CurrentMode))
     {
-        TSoftClassPtr<UUserWidget> ModeWidget = ModeSpecificWidgets[CurrentMode];
-        if (ModeWidget.IsValid())
+        if (UUserWidget* Cached = ModeWidgets.FindRef(CurrentMode))
+        {
+            return Cached;
+        }
+
+        if (!ModeWidget->IsNull())
         {
-            if (UClass* WidgetClass = ModeWidget.LoadSynchronous())
+            UModeManagerSubsystem* ModeManager = GetModeManager();
+            if (UClass* WidgetClass = ModeManager ? ModeManager->LoadClassForMode(*ModeWidget) : ModeWidget->LoadSynchronous())
             {
-                return CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
+                UUserWidget* Widget = CreateWidget<UUserWidget>(GetWorld(), WidgetClass);
+                ModeWidgets.Add(CurrentMode, Widget);
+                return Widget;
             }
         }
     }
@@ -58,6 +68,8 @@ UUserWidget* UUIToolTemplate::CreateToolWidget_Implementation()
 
 void UUIToolTemplate::OnModeChanged_Implementation(EAppMode NewMode)
 {
+    bShowPending = false;
+
     if (bHideOnModeChange && bUIVisible)
     {
         HideToolUI();
@@ -65,6 +77,15 @@ void UUIToolTemplate::OnModeChanged_Implementation(EAppMode NewMode)
 
     Super::OnModeChanged_Implementation(NewMode);
 
+    // Widgets of other modes would keep their classes resident
+    for (auto It = ModeWidgets.CreateIterator(); It; ++It)
+    {
+        if (It.Key() != NewMode)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
     if (bIsActive)
     {
         UpdateUIForMode(NewMode);
@@ -76,6 +97,19 @@ void UUIToolTemplate::OnModeChanged_Implementation(EAppMode NewMode)
     }
 }
 
+void UUIToolTemplate::GetPrewarmAssets(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths) const
+{
+    Super::GetPrewarmAssets(Mode, OutPaths);
+
+    if (const TSoftClassPtr<UUserWidget>* ModeWidget = ModeSpecificWidgets.Find(Mode))
+    {
+        if (!ModeWidget->IsNull())
+        {
+            OutPaths.AddUnique(ModeWidget->ToSoftObjectPath());
+        }
+    }
+}
+
 void UUIToolTemplate::ShowToolUI()
 {
     if (bUIVisible)
@@ -83,6 +117,33 @@ void UUIToolTemplate::ShowToolUI()
         return;
     }
 
+    // Stream the class in instead of hitching on a synchronous load
+    const TSoftClassPtr<UUserWidget>& WidgetClass = GetWidgetClassForMode(CurrentMode);
+    UModeManagerSubsystem* ModeManager = GetModeManager();
+    if (ModeManager && !WidgetClass.IsNull() && !WidgetClass.Get() && !ModeWidgets.Contains(CurrentMode))
+    {
+        if (FailedWidgetClasses.Contains(WidgetClass.ToSoftObjectPath()))
+        {
+            return;
+        }
+
+        if (!bShowPending)
+        {
+            bShowPending = true;
+            const EAppMode Mode = CurrentMode;
+            TWeakObjectPtr<UUIToolTemplate> WeakThis(this);
+            ModeManager->LoadForModeAsync(WidgetClass.ToSoftObjectPath(), [WeakThis, Mode](UObject*)
+            {
+                if (UUIToolTemplate* This = WeakThis.Get())
+                {
+                    This->HandleWidgetClassLoaded(Mode);
+                }
+            });
+        }
+        return;
+    }
+    bShowPending = false;
+
     UUserWidget* Widget = CreateToolWidget_Implementation();
     if (!Widget)
     {
@@ -92,9 +153,10 @@ void UUIToolTemplate::ShowToolUI()
 
     if (UUIManagerSubsystem* UIManager = GetUIManager())
     {
-        // Create a unique UI name for this tool instance
-        FName UIName = FName(*FString::Printf(TEXT("Tool_%s"), *ToolMetadata.ToolName));
-        UIManager->PushUI(UIName, TargetUILayer);
+        // The tool keeps its widget and shows the same one again next time
+        const FName UIName = FName(*FString::Printf(TEXT("Tool_%s"), *ToolMetadata.ToolName));
+        UIManager->PushWidget(Widget, TargetUILayer, UIName, EUIWidgetOwnership::Caller);
+        ShownWidget = Widget;
 
         bUIVisible = true;
         OnUIShown();
@@ -106,6 +168,8 @@ void UUIToolTemplate::ShowToolUI()
 
 void UUIToolTemplate::HideToolUI()
 {
+    bShowPending = false;
+
     if (!bUIVisible)
     {
         return;
@@ -113,7 +177,8 @@ void UUIToolTemplate::HideToolUI()
 
     if (UUIManagerSubsystem* UIManager = GetUIManager())
     {
-        UIManager->PopUI(TargetUILayer);
+        UIManager->RemoveWidget(ShownWidget);
+        ShownWidget = nullptr;
         bUIVisible = false;
         OnUIHidden();
 
@@ -135,6 +200,35 @@ bool UUIToolTemplate::IsUIVisible() const
     return bUIVisible;
 }
 
+const TSoftClassPtr<UUserWidget>& UUIToolTemplate::GetWidgetClassForMode(EAppMode Mode) const
+{
+    const TSoftClassPtr<UUserWidget>* ModeWidget = ModeSpecificWidgets.Find(Mode);
+    return ModeWidget && !ModeWidget->IsNull() ? *ModeWidget : ToolWidgetClass;
+}
+
+void UUIToolTemplate::HandleWidgetClassLoaded(EAppMode Mode)
+{
+    // Hidden, deactivated or the mode changed while loading
+    if (!bShowPending || !bIsActive || Mode != CurrentMode)
+    {
+        return;
+    }
+
+    bShowPending = false;
+
+    // Showing now would start the same load again, every frame for a broken class path
+    const TSoftClassPtr<UUserWidget>& WidgetClass = GetWidgetClassForMode(Mode);
+    if (!WidgetClass.Get())
+    {
+        FailedWidgetClasses.Add(WidgetClass.ToSoftObjectPath());
+        UE_LOG(LogMode, Warning, TEXT("Widget class %s of tool %s failed to load, its UI is not shown"),
+            *WidgetClass.ToString(), *ToolMetadata.ToolName);
+        return;
+    }
+
+    ShowToolUI();
+}
+
 void UUIToolTemplate::UpdateUIForMode(EAppMode Mode)
 {
     if (bUIVisible && ModeSpecificWidgets.Contains(Mode))
@@ -0,0 +1,58 @@
+#include "TwinPluginFramework/UI/ToolPaletteEntry.h"
+#include "Subsystems/GlobalServices.h"
+#include "Subsystems/IconManagerSubsystem.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/HorizontalBox.h"
+#include "Components/HorizontalBoxSlot.h"
+#include "Components/Image.h"
+#include "Components/TextBlock.h"
+#include "Engine/Texture2D.h"
+
+TSharedRef<SWidget> UToolPaletteEntryWidget::RebuildWidget()
+{
+    if (WidgetTree && !WidgetTree->RootWidget)
+    {
+        UHorizontalBox* Row = WidgetTree->ConstructWidget<UHorizontalBox>(UHorizontalBox::StaticClass(), TEXT("Row"));
+        WidgetTree->RootWidget = Row;
+
+        IconImage = WidgetTree->ConstructWidget<UImage>(UImage::StaticClass(), TEXT("IconImage"));
+        IconImage->SetDesiredSizeOverride(IconSize);
+        Row->AddChildToHorizontalBox(IconImage)->SetVerticalAlignment(VAlign_Center);
+
+        NameText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("NameText"));
+        UHorizontalBoxSlot* NameSlot = Row->AddChildToHorizontalBox(NameText);
+        NameSlot->SetVerticalAlignment(VAlign_Center);
+        NameSlot->SetPadding(FMargin(6.0f, 0.0f));
+    }
+    return Super::RebuildWidget();
+}
+
+void UToolPaletteEntryWidget::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+    Item = Cast<UToolPaletteItem>(ListItemObject);
+
+    if (NameText)
+    {
+        NameText->SetText(Item ? FText::FromString(Item->Metadata.ToolName) : FText::GetEmpty());
+    }
+
+    if (IconImage)
+    {
+        if (UIconManagerSubsystem* IconManager = UGlobalServices::GetIconManager(this))
+        {
+            IconManager->SetImageIcon(IconImage, Item ? Item->Metadata.Icon : TSoftObjectPtr<UTexture2D>());
+        }
+    }
+
+    OnToolItemSet(Item);
+}
+
+void UToolPaletteEntryWidget::NativeOnEntryReleased()
+{
+    // Scrolled out of view, its icon no longer needs to be loaded or kept in the atlas
+    if (UIconManagerSubsystem* IconManager = UGlobalServices::GetIconManager(this))
+    {
+        IconManager->ClearImageIcon(IconImage);
+    }
+    Item = nullptr;
+}
@@ -0,0 +1,359 @@
+#include "TwinPluginFramework/UI/ToolPaletteWidget.h"
+#include "TwinPluginFramework/UI/ToolPaletteEntry.h"
+#include "TwinPluginFramework/Core/TwinPluginManager.h"
+#include "Subsystems/GlobalServices.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/ListView.h"
+#include "Components/TileView.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/IConsoleManager.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "Core/Logs.h"
+
+TSharedRef<SWidget> UToolPaletteWidget::RebuildWidget()
+{
+    if (WidgetTree && !WidgetTree->RootWidget && !ToolList)
+    {
+        if (bUseTileView)
+        {
+            UTileView* Tiles = WidgetTree->ConstructWidget<UTileView>(UTileView::StaticClass(), TEXT("ToolList"));
+            Tiles->SetEntryWidth(TileSize.X);
+            Tiles->SetEntryHeight(TileSize.Y);
+            ToolList = Tiles;
+        }
+        else
+        {
+            ToolList = WidgetTree->ConstructWidget<UListView>(UListView::StaticClass(), TEXT("ToolList"));
+        }
+
+        // UListViewBase has no setter for its entry class, it is normally set in the designer
+        if (FClassProperty* EntryClassProperty = FindFProperty<FClassProperty>(UListViewBase::StaticClass(), TEXT("EntryWidgetClass")))
+        {
+            UClass* EntryClass = EntryWidgetClass ? *EntryWidgetClass : UToolPaletteEntryWidget::StaticClass();
+            EntryClassProperty->SetObjectPropertyValue_InContainer(ToolList, EntryClass);
+        }
+        WidgetTree->RootWidget = ToolList;
+    }
+    return Super::RebuildWidget();
+}
+
+void UToolPaletteWidget::NativeConstruct()
+{
+    Super::NativeConstruct();
+
+    if (ToolList)
+    {
+        ToolList->OnItemClicked().AddUObject(this, &UToolPaletteWidget::HandleItemClicked);
+    }
+
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        ToolEventHandle = EventBus->Subscribe(this, &UToolPaletteWidget::HandleToolEvent);
+    }
+
+    if (Items.Num() == 0)
+    {
+        RebuildCatalog();
+    }
+}
+
+void UToolPaletteWidget::NativeDestruct()
+{
+    if (ToolList)
+    {
+        ToolList->OnItemClicked().RemoveAll(this);
+    }
+
+    if (UEventBusSubsystem* EventBus = UGlobalServices::GetEventBus(this))
+    {
+        EventBus->Unsubscribe(ToolEventHandle);
+    }
+
+    Super::NativeDestruct();
+}
+
+void UToolPaletteWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+    Super::NativeTick(MyGeometry, InDeltaTime);
+
+    if (bFilterDirty)
+    {
+        ApplyFilter();
+    }
+}
+
+void UToolPaletteWidget::SetSearchText(const FString& Text)
+{
+    if (SearchText != Text)
+    {
+        SearchText = Text;
+        bFilterDirty = true;
+    }
+}
+
+void UToolPaletteWidget::SetCategoryFilter(EToolCategory Category)
+{
+    CategoryFilter = Category;
+    bFilterDirty = true;
+}
+
+void UToolPaletteWidget::ClearCategoryFilter()
+{
+    CategoryFilter.Reset();
+    bFilterDirty = true;
+}
+
+void UToolPaletteWidget::RebuildCatalog()
+{
+    if (UTwinPluginManager* PluginManager = UGlobalServices::GetPluginManager(this))
+    {
+        SetCatalog(PluginManager->GetRegisteredTools());
+    }
+}
+
+void UToolPaletteWidget::SetCatalog(const TArray<FRegisteredTool>& Tools)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UToolPaletteWidget::SetCatalog);
+
+    // Slots are handed out from zero again, SetTool keeps a slot's item only if its tool is unchanged
+    SearchIndex.Reset();
+    Items.SetNum(FMath::Min(Items.Num(), Tools.Num()));
+    for (const FRegisteredTool& Tool : Tools)
+    {
+        SetTool(Tool);
+    }
+
+    bFilterDirty = true;
+    UE_LOG(LogUI, Log, TEXT("ToolPalette: Indexed %d tools"), SearchIndex.Num());
+}
+
+void UToolPaletteWidget::SetTool(const FRegisteredTool& Tool)
+{
+    if (!Tool.bEnabled)
+    {
+        RemoveTool(Tool.ToolID);
+        return;
+    }
+
+    const int32 Slot = SearchIndex.Add(Tool.ToolID, Tool.Metadata);
+    if (Slot >= Items.Num())
+    {
+        Items.SetNum(Slot + 1);
+    }
+
+    // The list view keeps the entry widget of an item it already shows, so an item is never
+    // edited in place: a slot whose tool or metadata changed gets a new one and a new entry
+    const UToolPaletteItem* Existing = Items[Slot];
+    if (Existing && Existing->ToolID == Tool.ToolID
+        && FToolMetadata::StaticStruct()->CompareScriptStruct(&Existing->Metadata, &Tool.Metadata, PPF_None))
+    {
+        return;
+    }
+
+    UToolPaletteItem* Item = NewObject<UToolPaletteItem>(this);
+    Item->ToolID = Tool.ToolID;
+    Item->Metadata = Tool.Metadata;
+    Items[Slot] = Item;
+}
+
+void UToolPaletteWidget::RemoveTool(const FString& ToolID)
+{
+    const int32 Slot = SearchIndex.FindSlot(ToolID);
+    if (Slot != INDEX_NONE)
+    {
+        SearchIndex.Remove(ToolID);
+        Items[Slot] = nullptr;
+    }
+}
+
+void UToolPaletteWidget::ApplyFilter()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UToolPaletteWidget::ApplyFilter);
+    bFilterDirty = false;
+
+    TArray<int32> Slots;
+    SearchIndex.Search(SearchText, Slots);
+
+    ShownItems.Reset(Slots.Num());
+    for (const int32 Slot : Slots)
+    {
+        UToolPaletteItem* Item = Items.IsValidIndex(Slot) ? Items[Slot].Get() : nullptr;
+        if (Item && (!CategoryFilter.IsSet() || Item->Metadata.Category == CategoryFilter.GetValue()))
+        {
+            ShownItems.Add(Item);
+        }
+    }
+
+    // Entries of items still shown are kept, only newly visible rows get an entry widget
+    if (ToolList)
+    {
+        ToolList->SetListItems(ShownItems);
+    }
+}
+
+void UToolPaletteWidget::HandleToolEvent(const FToolEvent& Event)
+{
+    const FString ToolID = Event.ToolTopic.ToString();
+    if (Event.Type == EToolEventType::Registered)
+    {
+        UTwinPluginManager* PluginManager = UGlobalServices::GetPluginManager(this);
+        if (const FRegisteredTool* Tool = PluginManager ? PluginManager->FindRegisteredTool(ToolID) : nullptr)
+        {
+            SetTool(*Tool);
+            bFilterDirty = true;
+        }
+    }
+    else if (Event.Type == EToolEventType::Unregistered)
+    {
+        RemoveTool(ToolID);
+        bFilterDirty = true;
+    }
+}
+
+void UToolPaletteWidget::HandleItemClicked(UObject* ClickedItem)
+{
+    const UToolPaletteItem* Item = Cast<UToolPaletteItem>(ClickedItem);
+    if (!Item)
+    {
+        return;
+    }
+
+    OnToolPicked.Broadcast(Item->ToolID);
+
+    if (bActivateOnClick)
+    {
+        if (UTwinPluginManager* PluginManager = UGlobalServices::GetPluginManager(this))
+        {
+            PluginManager->ActivateTool(Item->ToolID);
+        }
+    }
+}
+
+static TArray<FRegisteredTool> MakeSyntheticCatalog(int32 NumTools)
+{
+    static const TCHAR* Verbs[] = { TEXT("Measure"), TEXT("Section"), TEXT("Annotate"), TEXT("Export"), TEXT("Isolate"), TEXT("Inspect"),
+        TEXT("Filter"), TEXT("Align"), TEXT("Snap"), TEXT("Simulate"), TEXT("Render"), TEXT("Compare") };
+    static const TCHAR* Nouns[] = { TEXT("Distance"), TEXT("Area"), TEXT("Volume"), TEXT("Grid"), TEXT("Sensor"), TEXT("Pipe"),
+        TEXT("Beam"), TEXT("Floor"), TEXT("Zone"), TEXT("Cable"), TEXT("Valve"), TEXT("Camera") };
+
+    TArray<FRegisteredTool> Tools;
+    Tools.SetNum(NumTools);
+    for (int32 Index = 0; Index < NumTools; ++Index)
+    {
+        FRegisteredTool& Tool = Tools[Index];
+        Tool.ToolID = FString::Printf(TEXT("Bench.Tool%d"), Index);
+        Tool.Metadata.ToolName = FString::Printf(TEXT("%s %s %d"), Verbs[Index % UE_ARRAY_COUNT(Verbs)],
+            Nouns[(Index / UE_ARRAY_COUNT(Verbs)) % UE_ARRAY_COUNT(Nouns)], Index);
+        Tool.Metadata.Description = FString::Printf(TEXT("Synthetic tool %d of the palette benchmark"), Index);
+        Tool.Metadata.Priority = Index % 200;
+    }
+    return Tools;
+}
+
+static void RunPaletteBench(const TArray<FString>& Args, UWorld* World)
+{
+    const int32 NumTools = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+    const TArray<FRegisteredTool> Tools = MakeSyntheticCatalog(NumTools);
+
+    // Search: indexing, a query typed one key at a time and queries that cannot narrow an earlier one
+    FToolSearchIndex Index;
+    double Start = FPlatformTime::Seconds();
+    for (const FRegisteredTool& Tool : Tools)
+    {
+        Index.Add(Tool.ToolID, Tool.Metadata);
+    }
+    const double IndexMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+    TArray<int32> Slots;
+    const FString Typed = TEXT("measure area 4");
+    double TypedTotalMs = 0.0;
+    double TypedMaxMs = 0.0;
+    for (int32 Length = 1; Length <= Typed.Len(); ++Length)
+    {
+        Start = FPlatformTime::Seconds();
+        Index.Search(Typed.Left(Length), Slots);
+        const double Ms = (FPlatformTime::Seconds() - Start) * 1000.0;
+        TypedTotalMs += Ms;
+        TypedMaxMs = FMath::Max(TypedMaxMs, Ms);
+    }
+
+    static const TCHAR* ColdQueries[] = { TEXT("sensor"), TEXT("ali"), TEXT("export valve"), TEXT("benchmark 99"), TEXT("no such tool") };
+    double ColdTotalMs = 0.0;
+    double ColdMaxMs = 0.0;
+    for (const TCHAR* Query : ColdQueries)
+    {
+        Start = FPlatformTime::Seconds();
+        Index.Search(Query, Slots);
+        const double Ms = (FPlatformTime::Seconds() - Start) * 1000.0;
+        ColdTotalMs += Ms;
+        ColdMaxMs = FMath::Max(ColdMaxMs, Ms);
+    }
+
+    UE_LOG(LogUI, Display, TEXT("Palette bench: %d tools indexed in %.2fms (%.1f KB)"),
+        NumTools, IndexMs, Index.GetStats().MemoryBytes / 1024.0);
+    UE_LOG(LogUI, Display, TEXT("Palette bench: typing \"%s\" %.3fms avg, %.3fms max per key; cold queries %.3fms avg, %.3fms max"),
+        *Typed, TypedTotalMs / Typed.Len(), TypedMaxMs, ColdTotalMs / UE_ARRAY_COUNT(ColdQueries), ColdMaxMs);
+
+    // Scroll: a palette on screen jumps through the catalog, so every frame shows rows it never showed before
+    if (!World || !World->GetGameViewport())
+    {
+        UE_LOG(LogUI, Display, TEXT("Palette bench: no game viewport, scroll timing skipped"));
+        return;
+    }
+
+    UToolPaletteWidget* Palette = CreateWidget<UToolPaletteWidget>(World, UToolPaletteWidget::StaticClass());
+    if (!Palette)
+    {
+        return;
+    }
+    Palette->bActivateOnClick = false;
+    Palette->AddToViewport(1000);
+    Palette->SetCatalog(Tools);
+
+    static constexpr int32 WarmupFrames = 5;
+    static constexpr int32 ScrollFrames = 240;
+    const float Step = static_cast<float>(NumTools) / ScrollFrames;
+    TWeakObjectPtr<UToolPaletteWidget> WeakPalette = Palette;
+    int32 Frame = 0;
+    double TotalMs = 0.0;
+    double MaxMs = 0.0;
+    int32 SlowFrames = 0;
+
+    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+        [WeakPalette, Step, Frame, TotalMs, MaxMs, SlowFrames](float DeltaTime) mutable
+    {
+        UToolPaletteWidget* Palette = WeakPalette.Get();
+        UListView* List = Palette ? Palette->GetToolList() : nullptr;
+        if (!List)
+        {
+            return false;
+        }
+
+        // The first frames build the list and its first entries
+        const int32 ScrollFrame = Frame++ - WarmupFrames;
+        if (ScrollFrame > 0)
+        {
+            const double Ms = DeltaTime * 1000.0;
+            TotalMs += Ms;
+            MaxMs = FMath::Max(MaxMs, Ms);
+            SlowFrames += Ms > 1000.0 / 60.0 ? 1 : 0;
+        }
+
+        if (ScrollFrame < ScrollFrames)
+        {
+            List->SetScrollOffset(FMath::Max(ScrollFrame, 0) * Step);
+            return true;
+        }
+
+        UE_LOG(LogUI, Display, TEXT("Palette bench: scrolling %d frames, %.2fms avg, %.2fms max frame, %d frames over 16.7ms"),
+            ScrollFrames, TotalMs / ScrollFrames, MaxMs, SlowFrames);
+        Palette->RemoveFromParent();
+        return false;
+    }));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs PaletteBenchCommand(
+    TEXT("Twin.Tools.PaletteBench"),
+    TEXT("Fills a synthetic tool catalog, times search on it and frame times while a palette scrolls through it. Usage: Twin.Tools.PaletteBench [NumTools]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunPaletteBench));
@@ -0,0 +1,308 @@
+#include "TwinPluginFramework/UI/ToolSearchIndex.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+
+namespace ToolSearchIndex
+{
+    static bool IsTermChar(TCHAR Char)
+    {
+        return !FChar::IsWhitespace(Char);
+    }
+
+    static uint64 MakeTrigram(const TCHAR* Chars)
+    {
+        return (static_cast<uint64>(Chars[0] & 0xFFFF) << 32) | (static_cast<uint64>(Chars[1] & 0xFFFF) << 16) | static_cast<uint64>(Chars[2] & 0xFFFF);
+    }
+}
+
+int32 FToolSearchIndex::Add(const FString& ToolID, const FToolMetadata& Metadata)
+{
+    Remove(ToolID);
+
+    const int32 Slot = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+    FEntry& Entry = Entries[Slot];
+    Entry.ToolID = ToolID;
+    Entry.Text = Metadata.ToolName.ToLower();
+    Entry.NameLength = Entry.Text.Len();
+    Entry.Text += TEXT("\n");
+    Entry.Text += Metadata.Description.ToLower();
+    Entry.Priority = Metadata.Priority;
+
+    GetTrigrams(Entry.Text, Entry.Trigrams);
+    for (const uint64 Trigram : Entry.Trigrams)
+    {
+        TArray<int32>& Posting = Postings.FindOrAdd(Trigram);
+        Posting.Insert(Slot, Algo::LowerBound(Posting, Slot));
+    }
+
+    SlotsByID.Add(ToolID, Slot);
+    Invalidate();
+    return Slot;
+}
+
+bool FToolSearchIndex::Remove(const FString& ToolID)
+{
+    int32 Slot = INDEX_NONE;
+    if (!SlotsByID.RemoveAndCopyValue(ToolID, Slot))
+    {
+        return false;
+    }
+
+    FEntry& Entry = Entries[Slot];
+    for (const uint64 Trigram : Entry.Trigrams)
+    {
+        if (TArray<int32>* Posting = Postings.Find(Trigram))
+        {
+            const int32 Index = Algo::BinarySearch(*Posting, Slot);
+            if (Index != INDEX_NONE)
+            {
+                Posting->RemoveAt(Index, 1, EAllowShrinking::No);
+            }
+            if (Posting->Num() == 0)
+            {
+                Postings.Remove(Trigram);
+            }
+        }
+    }
+
+    Entry = FEntry();
+    FreeSlots.Add(Slot);
+    Invalidate();
+    return true;
+}
+
+void FToolSearchIndex::Reset()
+{
+    Entries.Empty();
+    FreeSlots.Empty();
+    SlotsByID.Empty();
+    Postings.Empty();
+    Invalidate();
+}
+
+void FToolSearchIndex::Invalidate()
+{
+    Cache.Reset();
+    bRankDirty = true;
+}
+
+void FToolSearchIndex::GetTrigrams(const FString& Text, TArray<uint64>& OutTrigrams)
+{
+    OutTrigrams.Reset();
+
+    // Terms never contain whitespace, trigrams spanning it are not needed
+    const TCHAR* Chars = *Text;
+    for (int32 Index = 0; Index + 2 < Text.Len(); ++Index)
+    {
+        if (ToolSearchIndex::IsTermChar(Chars[Index]) && ToolSearchIndex::IsTermChar(Chars[Index + 1]) && ToolSearchIndex::IsTermChar(Chars[Index + 2]))
+        {
+            OutTrigrams.Add(ToolSearchIndex::MakeTrigram(Chars + Index));
+        }
+    }
+
+    OutTrigrams.Sort();
+    OutTrigrams.SetNum(Algo::Unique(OutTrigrams), EAllowShrinking::No);
+}
+
+void FToolSearchIndex::Search(const FString& Query, TArray<int32>& OutSlots)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    ++Searches;
+    OutSlots.Reset();
+
+    TArray<FString> Terms;
+    Query.ToLower().ParseIntoArrayWS(Terms);
+    const FString Normalized = FString::Join(Terms, TEXT(" "));
+
+    EnsureRanked();
+    if (Terms.Num() == 0)
+    {
+        OutSlots = Ranked;
+        return;
+    }
+
+    // The same query again, or the longest earlier one this query extends
+    const FCachedSearch* Narrow = nullptr;
+    for (int32 Index = Cache.Num() - 1; Index >= 0; --Index)
+    {
+        const FCachedSearch& Cached = Cache[Index];
+        if (Cached.Query == Normalized)
+        {
+            ++CachedSearches;
+            OutSlots = Cached.Slots;
+            return;
+        }
+        if (Normalized.StartsWith(Cached.Query, ESearchCase::CaseSensitive) && (!Narrow || Cached.Query.Len() > Narrow->Query.Len()))
+        {
+            Narrow = &Cached;
+        }
+    }
+
+    if (Narrow)
+    {
+        ++NarrowedSearches;
+        for (const int32 Slot : Narrow->Slots)
+        {
+            if (MatchesAll(Entries[Slot], Terms))
+            {
+                OutSlots.Add(Slot);
+            }
+        }
+    }
+    else
+    {
+        // Seed with the shortest posting list of any term's trigrams
+        const TArray<int32>* Seed = nullptr;
+        bool bNoMatch = false;
+        TArray<uint64> TermTrigrams;
+        for (const FString& Term : Terms)
+        {
+            GetTrigrams(Term, TermTrigrams);
+            for (const uint64 Trigram : TermTrigrams)
+            {
+                const TArray<int32>* Posting = Postings.Find(Trigram);
+                if (!Posting)
+                {
+                    bNoMatch = true;
+                    break;
+                }
+                if (!Seed || Posting->Num() < Seed->Num())
+                {
+                    Seed = Posting;
+                }
+            }
+        }
+
+        if (!bNoMatch)
+        {
+            // Only short terms: every tool is a candidate
+            for (const int32 Slot : Seed ? *Seed : Ranked)
+            {
+                if (MatchesAll(Entries[Slot], Terms))
+                {
+                    OutSlots.Add(Slot);
+                }
+            }
+        }
+    }
+
+    SortResults(OutSlots, Terms);
+
+    if (Cache.Num() >= MaxCachedSearches)
+    {
+        Cache.RemoveAt(0, 1, EAllowShrinking::No);
+    }
+    FCachedSearch& Cached = Cache.AddDefaulted_GetRef();
+    Cached.Query = Normalized;
+    Cached.Slots = OutSlots;
+
+    LastSearchSeconds = FPlatformTime::Seconds() - StartTime;
+    MaxSearchSeconds = FMath::Max(MaxSearchSeconds, LastSearchSeconds);
+}
+
+bool FToolSearchIndex::MatchesAll(const FEntry& Entry, const TArray<FString>& Terms) const
+{
+    for (const FString& Term : Terms)
+    {
+        if (!Entry.Text.Contains(Term, ESearchCase::CaseSensitive))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32 FToolSearchIndex::ScoreName(const FEntry& Entry, const TArray<FString>& Terms) const
+{
+    // 3 name starts with the term, 2 a word of the name does, 1 name contains it
+    int32 Score = 0;
+    for (const FString& Term : Terms)
+    {
+        const int32 Index = Entry.Text.Find(Term, ESearchCase::CaseSensitive);
+        if (Index == 0)
+        {
+            Score += 3;
+        }
+        else if (Index != INDEX_NONE && Index < Entry.NameLength)
+        {
+            const bool bWordStart = FChar::IsWhitespace(Entry.Text[Index - 1]) || !FChar::IsAlnum(Entry.Text[Index - 1]);
+            Score += bWordStart ? 2 : 1;
+        }
+    }
+    return Score;
+}
+
+void FToolSearchIndex::SortResults(TArray<int32>& Slots, const TArray<FString>& Terms)
+{
+    TArray<TPair<int32, int32>> Keys;
+    Keys.Reserve(Slots.Num());
+    for (const int32 Slot : Slots)
+    {
+        Keys.Emplace(ScoreName(Entries[Slot], Terms), Slot);
+    }
+
+    Keys.Sort([this](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+    {
+        return A.Key != B.Key ? A.Key > B.Key : RankOfSlot[A.Value] < RankOfSlot[B.Value];
+    });
+
+    for (int32 Index = 0; Index < Keys.Num(); ++Index)
+    {
+        Slots[Index] = Keys[Index].Value;
+    }
+}
+
+void FToolSearchIndex::EnsureRanked()
+{
+    if (!bRankDirty)
+    {
+        return;
+    }
+
+    Ranked.Reset(SlotsByID.Num());
+    for (const auto& Pair : SlotsByID)
+    {
+        Ranked.Add(Pair.Value);
+    }
+    Ranked.Sort([this](int32 A, int32 B)
+    {
+        const FEntry& EntryA = Entries[A];
+        const FEntry& EntryB = Entries[B];
+        if (EntryA.Priority != EntryB.Priority)
+        {
+            return EntryA.Priority > EntryB.Priority;
+        }
+        return FCString::Strncmp(*EntryA.Text, *EntryB.Text, FMath::Min(EntryA.NameLength, EntryB.NameLength) + 1) < 0;
+    });
+
+    RankOfSlot.SetNumUninitialized(Entries.Num());
+    for (int32 Index = 0; Index < Ranked.Num(); ++Index)
+    {
+        RankOfSlot[Ranked[Index]] = Index;
+    }
+    bRankDirty = false;
+}
+
+FToolSearchStats FToolSearchIndex::GetStats() const
+{
+    FToolSearchStats Stats;
+    Stats.IndexedTools = SlotsByID.Num();
+    Stats.Trigrams = Postings.Num();
+    Stats.Searches = Searches;
+    Stats.NarrowedSearches = NarrowedSearches;
+    Stats.CachedSearches = CachedSearches;
+    Stats.LastSearchMs = static_cast<float>(LastSearchSeconds * 1000.0);
+    Stats.MaxSearchMs = static_cast<float>(MaxSearchSeconds * 1000.0);
+
+    Stats.MemoryBytes = Entries.GetAllocatedSize() + FreeSlots.GetAllocatedSize() + SlotsByID.GetAllocatedSize()
+        + Postings.GetAllocatedSize() + Ranked.GetAllocatedSize() + RankOfSlot.GetAllocatedSize();
+    for (const FEntry& Entry : Entries)
+    {
+        Stats.MemoryBytes += Entry.ToolID.GetAllocatedSize() + Entry.Text.GetAllocatedSize() + Entry.Trigrams.GetAllocatedSize();
+    }
+    for (const auto& Pair : Postings)
+    {
+        Stats.MemoryBytes += Pair.Value.GetAllocatedSize();
+    }
+    return Stats;
+}
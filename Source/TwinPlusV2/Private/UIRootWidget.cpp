@@ -0,0 +1,179 @@
+#include "UIRootWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Overlay.h"
+#include "Components/OverlaySlot.h"
+#include "Components/InvalidationBox.h"
+#include "Components/RetainerBox.h"
+
+UUIRootWidget::UUIRootWidget(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+    SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+
+    // HUD elements and popups are shown side by side, menus and backgrounds replace each other
+    LayerSettings.Add(EUILayer::Background, FUILayerSettings());
+    LayerSettings.Add(EUILayer::HUD, FUILayerSettings()).bCollapseCoveredWidgets = false;
+    LayerSettings.Add(EUILayer::Menu, FUILayerSettings());
+    LayerSettings.Add(EUILayer::Popup, FUILayerSettings()).bCollapseCoveredWidgets = false;
+}
+
+TSharedRef<SWidget> UUIRootWidget::RebuildWidget()
+{
+    if (WidgetTree && !WidgetTree->RootWidget)
+    {
+        BuildLayers();
+    }
+    return Super::RebuildWidget();
+}
+
+void UUIRootWidget::BuildLayers()
+{
+    UOverlay* Root = WidgetTree->ConstructWidget<UOverlay>(UOverlay::StaticClass(), TEXT("Layers"));
+    WidgetTree->RootWidget = Root;
+    Layers.Reset();
+
+    // Enum order is paint order
+    const UEnum* LayerEnum = StaticEnum<EUILayer>();
+    for (int32 Index = 0; Index < LayerEnum->NumEnums() - 1; ++Index)
+    {
+        const EUILayer Layer = static_cast<EUILayer>(LayerEnum->GetValueByIndex(Index));
+        const FString LayerName = LayerEnum->GetNameStringByIndex(Index);
+        const FUILayerSettings Settings = LayerSettings.FindRef(Layer);
+
+        FUIRootLayer& RootLayer = Layers.Add(Layer);
+        RootLayer.Stack = WidgetTree->ConstructWidget<UOverlay>(UOverlay::StaticClass(), *(LayerName + TEXT("Stack")));
+        RootLayer.Container = RootLayer.Stack;
+
+        if (Settings.Caching == EUILayerCaching::Invalidation)
+        {
+            UInvalidationBox* Box = WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), *(LayerName + TEXT("Cache")));
+            Box->SetCanCache(true);
+            Box->AddChild(RootLayer.Stack);
+            RootLayer.Container = Box;
+        }
+        else if (Settings.Caching == EUILayerCaching::Retainer)
+        {
+            URetainerBox* Box = WidgetTree->ConstructWidget<URetainerBox>(URetainerBox::StaticClass(), *(LayerName + TEXT("Retainer")));
+            Box->SetRenderingPhase(0, FMath::Max(1, Settings.RetainerPhaseCount));
+            Box->AddChild(RootLayer.Stack);
+            RootLayer.Container = Box;
+        }
+
+        UOverlaySlot* LayerSlot = Root->AddChildToOverlay(RootLayer.Container);
+        LayerSlot->SetHorizontalAlignment(HAlign_Fill);
+        LayerSlot->SetVerticalAlignment(VAlign_Fill);
+
+        UpdateLayer(Layer);
+    }
+}
+
+FUIRootLayer* UUIRootWidget::FindLayer(EUILayer Layer)
+{
+    if (WidgetTree && !WidgetTree->RootWidget)
+    {
+        BuildLayers();
+    }
+    return Layers.Find(Layer);
+}
+
+void UUIRootWidget::AddToLayer(EUILayer Layer, UUserWidget* Widget)
+{
+    FUIRootLayer* RootLayer = FindLayer(Layer);
+    if (!RootLayer || !Widget)
+    {
+        return;
+    }
+
+    Widget->RemoveFromParent();
+    UOverlaySlot* WidgetSlot = RootLayer->Stack->AddChildToOverlay(Widget);
+    WidgetSlot->SetHorizontalAlignment(HAlign_Fill);
+    WidgetSlot->SetVerticalAlignment(VAlign_Fill);
+
+    UpdateLayer(Layer);
+}
+
+void UUIRootWidget::RemoveFromLayer(EUILayer Layer, UUserWidget* Widget)
+{
+    FUIRootLayer* RootLayer = FindLayer(Layer);
+    if (!RootLayer || !Widget)
+    {
+        return;
+    }
+
+    // Leaves with the visibility it came with, it may be pooled and pushed again
+    ESlateVisibility Visibility;
+    if (RootLayer->CoveredVisibility.RemoveAndCopyValue(TObjectKey<UWidget>(Widget), Visibility))
+    {
+        Widget->SetVisibility(Visibility);
+    }
+    RootLayer->Stack->RemoveChild(Widget);
+
+    UpdateLayer(Layer);
+}
+
+void UUIRootWidget::SetLayerHidden(EUILayer Layer, bool bHidden)
+{
+    if (FUIRootLayer* RootLayer = FindLayer(Layer))
+    {
+        RootLayer->bHidden = bHidden;
+        UpdateLayer(Layer);
+    }
+}
+
+bool UUIRootWidget::IsLayerHidden(EUILayer Layer) const
+{
+    const FUIRootLayer* RootLayer = Layers.Find(Layer);
+    return RootLayer && RootLayer->bHidden;
+}
+
+int32 UUIRootWidget::GetPaintedWidgetCount(EUILayer Layer) const
+{
+    const FUIRootLayer* RootLayer = Layers.Find(Layer);
+    if (!RootLayer || !RootLayer->Stack || RootLayer->bHidden)
+    {
+        return 0;
+    }
+
+    int32 Painted = 0;
+    for (const UWidget* Child : RootLayer->Stack->GetAllChildren())
+    {
+        Painted += Child && Child->IsVisible() ? 1 : 0;
+    }
+    return Painted;
+}
+
+void UUIRootWidget::UpdateLayer(EUILayer Layer)
+{
+    FUIRootLayer* RootLayer = Layers.Find(Layer);
+    if (!RootLayer || !RootLayer->Stack)
+    {
+        return;
+    }
+
+    const bool bCollapseCovered = LayerSettings.FindRef(Layer).bCollapseCoveredWidgets;
+    const int32 NumChildren = RootLayer->Stack->GetChildrenCount();
+    for (int32 Index = 0; Index < NumChildren; ++Index)
+    {
+        UWidget* Child = RootLayer->Stack->GetChildAt(Index);
+        const TObjectKey<UWidget> Key(Child);
+        const bool bCovered = bCollapseCovered && Index < NumChildren - 1;
+
+        if (bCovered && !RootLayer->CoveredVisibility.Contains(Key))
+        {
+            RootLayer->CoveredVisibility.Add(Key, Child->GetVisibility());
+            Child->SetVisibility(ESlateVisibility::Collapsed);
+        }
+        else if (!bCovered)
+        {
+            ESlateVisibility Visibility;
+            if (RootLayer->CoveredVisibility.RemoveAndCopyValue(Key, Visibility))
+            {
+                Child->SetVisibility(Visibility);
+            }
+        }
+    }
+
+    // Collapsed layers are skipped by prepass and paint
+    RootLayer->Container->SetVisibility(RootLayer->bHidden || NumChildren == 0
+        ? ESlateVisibility::Collapsed : ESlateVisibility::SelfHitTestInvisible);
+}
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "Core/AppModes.h"
+#include "Subsystems/EventBusSubsystem.h"
 #include "TwinPlayerController.generated.h"
 
 UCLASS()
@@ -13,7 +14,13 @@ class TWINPLUSV2_API ATwinPlayerController : public APlayerController
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UFUNCTION()
     void HandleModeChanged(EAppMode NewMode);
+
+private:
+    void HandleModeChangedEvent(const FModeChangedEvent& Event);
+
+    FTwinEventHandle ModeChangedHandle;
 };
@@ -1,12 +1,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Engine/DataTable.h"
 #include "Core/AppModes.h"
 #include "AppModeEntry.generated.h"
 
+class UTexture2D;
+
 USTRUCT(BlueprintType)
-struct FAppModeEntry : public FTableRowBase
+struct FAppModeEntry
 {
     GENERATED_BODY()
 
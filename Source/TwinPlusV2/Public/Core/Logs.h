@@ -5,4 +5,5 @@ DECLARE_LOG_CATEGORY_EXTERN(LogUI, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogScene, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogMode, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(LogInputSys, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogEventBus, Log, All);
 
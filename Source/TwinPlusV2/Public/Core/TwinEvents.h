@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "Core/AppModes.h"
+#include "Core/AppState.h"
+#include "Core/UILayer.h"
+
+class UUserWidget;
+
+/**
+ * Native events published on UEventBusSubsystem.
+ *
+ * An event is a plain struct with a static GetEventName() and a GetTopic() that
+ * listeners can filter on (tool ID, layer, scene). Listeners receive it by const
+ * reference, nothing is copied unless a listener asked for end-of-frame delivery.
+ * Objects are held weakly since batched delivery may run after a garbage collection.
+ */
+#define TWIN_EVENT(Name) \
+    static FName GetEventName() { static const FName EventName(TEXT(#Name)); return EventName; }
+
+namespace TwinEvents
+{
+    inline FName LayerTopic(EUILayer Layer)
+    {
+        return UEnum::GetValueAsName(Layer);
+    }
+}
+
+struct FAppStateChangedEvent
+{
+    TWIN_EVENT(AppStateChanged)
+    FName GetTopic() const { return NAME_None; }
+
+    EAppState OldState = EAppState::None;
+    EAppState NewState = EAppState::None;
+};
+
+struct FModeTransitionStartedEvent
+{
+    TWIN_EVENT(ModeTransitionStarted)
+    FName GetTopic() const { return NAME_None; }
+
+    EAppMode FromMode = EAppMode::None;
+    EAppMode ToMode = EAppMode::None;
+};
+
+struct FModeChangedEvent
+{
+    TWIN_EVENT(ModeChanged)
+    FName GetTopic() const { return NAME_None; }
+
+    EAppMode OldMode = EAppMode::None;
+    EAppMode NewMode = EAppMode::None;
+};
+
+enum class ESceneEventType : uint8
+{
+    Loaded,
+    Unloaded,
+    Preloaded,
+    Hidden,
+    StateCaptured,
+    StateRestored
+};
+
+// Topic is the scene name
+struct FSceneEvent
+{
+    TWIN_EVENT(Scene)
+    FName GetTopic() const { return SceneName; }
+
+    ESceneEventType Type = ESceneEventType::Loaded;
+    FName SceneName;
+};
+
+// Topic is the scene name
+struct FActorIndexChangedEvent
+{
+    TWIN_EVENT(ActorIndexChanged)
+    FName GetTopic() const { return SceneName; }
+
+    FName SceneName;
+    int32 ActorsAdded = 0;
+    int32 ActorsRemoved = 0;
+};
+
+// Topic is the layer, see TwinEvents::LayerTopic
+struct FUIPushedEvent
+{
+    TWIN_EVENT(UIPushed)
+    FName GetTopic() const { return TwinEvents::LayerTopic(Layer); }
+
+    FName UIName;
+    EUILayer Layer = EUILayer::HUD;
+    TWeakObjectPtr<UUserWidget> Widget;
+};
+
+// Topic is the layer, see TwinEvents::LayerTopic
+struct FUIPoppedEvent
+{
+    TWIN_EVENT(UIPopped)
+    FName GetTopic() const { return TwinEvents::LayerTopic(Layer); }
+
+    EUILayer Layer = EUILayer::HUD;
+    TWeakObjectPtr<UUserWidget> Widget;
+};
+
+// One per applied batch of UI changes, after the batch's pushed and popped events
+struct FUIChangesAppliedEvent
+{
+    TWIN_EVENT(UIChangesApplied)
+    FName GetTopic() const { return NAME_None; }
+
+    int32 Pushed = 0;
+    int32 Popped = 0;
+    // Pushes and pops that undid each other and never reached the screen
+    int32 Cancelled = 0;
+};
+
+enum class EToolEventType : uint8
+{
+    Registered,
+    Unregistered,
+    Activated,
+    Deactivated
+};
+
+// Topic is the tool ID
+struct FToolEvent
+{
+    TWIN_EVENT(Tool)
+    FName GetTopic() const { return ToolTopic; }
+
+    EToolEventType Type = EToolEventType::Activated;
+    FName ToolTopic;
+    TWeakObjectPtr<UObject> Tool;
+};
+
+// Topic is the tool ID, like FToolEvent
+struct FToolProgressEvent
+{
+    TWIN_EVENT(ToolProgress)
+    FName GetTopic() const { return ToolTopic; }
+
+    FName ToolTopic;
+    TWeakObjectPtr<UObject> Tool;
+    float Progress = 0.0f;
+    FString Message;
+};
+
+// Topic is the tool ID, like FToolEvent
+struct FToolStateChangedEvent
+{
+    TWIN_EVENT(ToolStateChanged)
+    FName GetTopic() const { return ToolTopic; }
+
+    FName ToolTopic;
+    TWeakObjectPtr<UObject> Tool;
+    bool bActive = false;
+};
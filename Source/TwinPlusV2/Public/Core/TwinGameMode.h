@@ -8,6 +8,36 @@
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAppStateChanged, EAppState, NewState);
 
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FAppStateDispatchStats
+{
+    GENERATED_BODY()
+
+    // ApplyAppState calls
+    UPROPERTY(BlueprintReadOnly, Category = "AppState")
+    int32 Requests = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AppState")
+    int32 Dispatches = 0;
+
+    // Requests that were superseded or cancelled out within the same frame
+    UPROPERTY(BlueprintReadOnly, Category = "AppState")
+    int32 Coalesced = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AppState")
+    int32 LastListeners = 0;
+
+    // OnAppStateChanged listeners, then the resulting mode request
+    UPROPERTY(BlueprintReadOnly, Category = "AppState")
+    float LastListenerMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AppState")
+    float LastModeRequestMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "AppState")
+    float MaxDispatchMs = 0.0f;
+};
+
 UCLASS()
 class TWINPLUSV2_API ATwinGameMode : public AGameModeBase
 {
@@ -17,14 +47,32 @@ public:
     ATwinGameMode();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Queued: changes within a frame collapse to the last one, which is dispatched
+    // once after this world's actors ticked. Calls from listeners land in the next frame.
     void ApplyAppState(EAppState NewState);
 
+    // Dispatches a queued change now instead of after the actor tick
+    void FlushAppState();
+
     EAppState GetCurrentAppState() const { return CurrentAppState; }
+    bool HasPendingAppState() const { return PendingAppState.IsSet(); }
+
+    const FAppStateDispatchStats& GetAppStateDispatchStats() const { return DispatchStats; }
 
     UPROPERTY(BlueprintAssignable)
     FOnAppStateChanged OnAppStateChanged;
 
 private:
     EAppState CurrentAppState = EAppState::Explore;
+
+    TOptional<EAppState> PendingAppState;
+    bool bDispatchingAppState = false;
+    FDelegateHandle PostActorTickHandle;
+    FAppStateDispatchStats DispatchStats;
+
+    void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+    void DispatchAppState();
     //void RegisterExampleTools();
 };
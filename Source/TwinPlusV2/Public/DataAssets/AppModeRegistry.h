@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "Core/AppModeEntry.h"
+#include "DataAssets/IndexedRegistry.h"
 #include "AppModeRegistry.generated.h"
 
 UCLASS(BlueprintType)
@@ -13,15 +14,21 @@ class TWINPLUSV2_API UAppModeRegistry : public UDataAsset
 public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Modes")
     TArray<FAppModeEntry> Modes;
-    const FAppModeEntry* FindMode(EAppMode Mode) const
-    {
-        for (const FAppModeEntry& Entry : Modes)
-        {
-            if (Entry.Mode == Mode)
-            {
-                return &Entry;
-            }
-        }
-        return nullptr;
-    }
+
+    const FAppModeEntry* FindMode(EAppMode Mode) const { return ModeIndex.Find(Modes, Mode); }
+
+    // Long package name of the mode's level
+    const FAppModeEntry* FindModeByLevel(FName LevelPackageName) const { return LevelIndex.Find(Modes, LevelPackageName); }
+
+    // Call after changing Modes at runtime
+    void RebuildIndex();
+
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    TIndexedRegistry<FAppModeEntry, EAppMode> ModeIndex{ [](const FAppModeEntry& Entry) { return Entry.Mode; } };
+    TIndexedRegistry<FAppModeEntry, FName> LevelIndex{ [](const FAppModeEntry& Entry) { return Entry.Level.ToSoftObjectPath().GetLongPackageFName(); } };
 };
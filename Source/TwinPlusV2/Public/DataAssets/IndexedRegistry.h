@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hashed key -> entry index over a registry DataAsset's entry array.
+ * The array stays the edited/serialized data; the index is rebuilt from it in
+ * PostLoad and PostEditChangeProperty. Lookups never allocate, as long as the
+ * key function does not: every hit reads the entry's key, so return member keys
+ * by reference (KeyResultType const KeyType&) and derive others without strings.
+ *
+ * If the array was resized without a rebuild, lookups fall back to a linear scan
+ * instead of returning a wrong entry. An entry whose key was edited in place is
+ * not returned for its old key, but is only found by its new key after a rebuild.
+ */
+template <typename EntryType, typename KeyType, typename KeyResultType = KeyType>
+class TIndexedRegistry
+{
+public:
+    using FKeyFunc = TFunction<KeyResultType(const EntryType&)>;
+
+    explicit TIndexedRegistry(FKeyFunc InGetKey)
+        : GetKey(MoveTemp(InGetKey))
+    {
+    }
+
+    // Returns the number of duplicate keys, the first entry with a key wins
+    int32 Rebuild(const TArray<EntryType>& Entries)
+    {
+        Lookup.Reset();
+        Lookup.Reserve(Entries.Num());
+
+        int32 Duplicates = 0;
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            const KeyResultType Key = GetKey(Entries[Index]);
+            if (Key == KeyType())
+            {
+                continue;
+            }
+
+            if (Lookup.Contains(Key))
+            {
+                ++Duplicates;
+                continue;
+            }
+            Lookup.Add(Key, Index);
+        }
+
+        BuiltData = Entries.GetData();
+        BuiltNum = Entries.Num();
+        return Duplicates;
+    }
+
+    const EntryType* Find(const TArray<EntryType>& Entries, const KeyType& Key) const
+    {
+        const int32 Index = FindIndex(Entries, Key);
+        return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+    }
+
+    int32 FindIndex(const TArray<EntryType>& Entries, const KeyType& Key) const
+    {
+        if (IsCurrent(Entries))
+        {
+            const int32* Index = Lookup.Find(Key);
+            if (!Index)
+            {
+                return INDEX_NONE;
+            }
+            if (GetKey(Entries[*Index]) == Key)
+            {
+                return *Index;
+            }
+        }
+
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            if (GetKey(Entries[Index]) == Key)
+            {
+                return Index;
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    // Indexes an entry appended with Add instead of rebuilding
+    void OnAppended(const TArray<EntryType>& Entries)
+    {
+        if (BuiltNum != Entries.Num() - 1)
+        {
+            Rebuild(Entries);
+            return;
+        }
+
+        const KeyResultType Key = GetKey(Entries.Last());
+        if (Key != KeyType() && !Lookup.Contains(Key))
+        {
+            Lookup.Add(Key, Entries.Num() - 1);
+        }
+        BuiltData = Entries.GetData();
+        BuiltNum = Entries.Num();
+    }
+
+    bool IsCurrent(const TArray<EntryType>& Entries) const
+    {
+        return BuiltData == Entries.GetData() && BuiltNum == Entries.Num();
+    }
+
+    int32 Num() const { return Lookup.Num(); }
+    SIZE_T GetAllocatedSize() const { return Lookup.GetAllocatedSize(); }
+
+private:
+    FKeyFunc GetKey;
+    TMap<KeyType, int32> Lookup;
+    const EntryType* BuiltData = nullptr;
+    int32 BuiltNum = 0;
+};
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "Engine/PrimaryAssetLabel.h"
+#include "DataAssets/IndexedRegistry.h"
 #include "SceneRegistry.generated.h"
 
 USTRUCT(BlueprintType)
@@ -15,6 +16,21 @@ struct FSceneEntry
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
     TSoftObjectPtr<UWorld> LevelPath;
+
+    // Likely next scenes, preloaded in the background while this one is current
+    UPROPERTY(EditAnywhere, BlueprintReadOnly)
+    TArray<FName> AdjacentScenes;
+
+    // Residency cache cost, measured from the loaded level when 0
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0"))
+    float EstimatedMemoryMB = 0.0f;
+
+    // Spatial cells are streamed by camera position instead of by name
+    UPROPERTY(EditAnywhere, BlueprintReadOnly)
+    bool bSpatialCell = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "bSpatialCell"))
+    FBox Bounds = FBox(ForceInit);
 };
 
 UCLASS(BlueprintType)
@@ -25,4 +41,21 @@ class TWINPLUSV2_API USceneRegistry : public UDataAsset
 public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
     TArray<FSceneEntry> Scenes;
+
+    const FSceneEntry* FindScene(FName SceneName) const { return SceneIndex.Find(Scenes, SceneName); }
+
+    // Long package name of the level, e.g. /Game/Maps/Plant_A
+    const FSceneEntry* FindSceneByLevel(FName LevelPackageName) const { return LevelIndex.Find(Scenes, LevelPackageName); }
+
+    // Call after changing Scenes at runtime
+    void RebuildIndex();
+
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    TIndexedRegistry<FSceneEntry, FName> SceneIndex{ [](const FSceneEntry& Entry) { return Entry.SceneName; } };
+    TIndexedRegistry<FSceneEntry, FName> LevelIndex{ [](const FSceneEntry& Entry) { return Entry.LevelPath.ToSoftObjectPath().GetLongPackageFName(); } };
 };
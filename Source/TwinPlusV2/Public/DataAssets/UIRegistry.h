@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "Blueprint/UserWidget.h"
+#include "DataAssets/IndexedRegistry.h"
+#include "Core/AppModes.h"
 #include "UIRegistry.generated.h"
 USTRUCT(BlueprintType)
 struct FUIEntry
@@ -14,6 +16,14 @@ struct FUIEntry
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
     TSoftClassPtr<UUserWidget> WidgetClass;
+
+    // Modes that show this widget, it is streamed in while transitioning into them
+    UPROPERTY(EditAnywhere, BlueprintReadOnly)
+    TArray<EAppMode> Modes;
+
+    // Popped widgets kept for the next push, 0 creates a new widget every time
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0"))
+    int32 PoolSize = 1;
 };
 
 UCLASS(BlueprintType)
@@ -25,13 +35,16 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
     TArray<FUIEntry> UIEntries;
 
-    const FUIEntry* FindEntry(FName Name) const
-    {
-        for (const FUIEntry& Entry : UIEntries)
-        {
-            if (Entry.UIName == Name)
-                return &Entry;
-        }
-        return nullptr;
-    }
+    const FUIEntry* FindEntry(FName Name) const { return EntryIndex.Find(UIEntries, Name); }
+
+    // Call after changing UIEntries at runtime
+    void RebuildIndex();
+
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    TIndexedRegistry<FUIEntry, FName> EntryIndex{ [](const FUIEntry& Entry) { return Entry.UIName; } };
 };
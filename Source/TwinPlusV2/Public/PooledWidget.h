@@ -0,0 +1,24 @@
+#pragma once
+#include "UObject/Interface.h"
+#include "PooledWidget.generated.h"
+
+// Widgets reused by UUIManagerSubsystem's pool implement this to reset their state
+UINTERFACE(MinimalAPI, Blueprintable)
+class UPooledWidget : public UInterface
+{
+    GENERATED_BODY()
+};
+
+class IPooledWidget
+{
+    GENERATED_BODY()
+
+public:
+    // After the widget was popped and kept: stop timers and animations, drop references
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "UI|Pool")
+    void OnReturnedToPool();
+
+    // Before a kept widget is pushed again: bring it back to the state of a new widget
+    UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "UI|Pool")
+    void OnTakenFromPool();
+};
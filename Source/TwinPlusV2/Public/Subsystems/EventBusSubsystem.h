@@ -0,0 +1,225 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Core/TwinEvents.h"
+#include "EventBusSubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class ETwinEventDelivery : uint8
+{
+    // Called from Publish
+    Immediate   UMETA(DisplayName = "Immediate"),
+    // Queued and delivered in publish order at the end of the frame
+    EndOfFrame  UMETA(DisplayName = "End Of Frame")
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FTwinEventHandle
+{
+    GENERATED_BODY()
+
+    uint64 Id = 0;
+
+    bool IsValid() const { return Id != 0; }
+    void Reset() { Id = 0; }
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FTwinEventListenerStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Events")
+    FName EventName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Events")
+    FName ListenerName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Events")
+    FName Topic;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Events")
+    int32 Priority = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Events")
+    ETwinEventDelivery Delivery = ETwinEventDelivery::Immediate;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Events")
+    int32 Calls = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Events")
+    float TotalMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Events")
+    float MaxMs = 0.0f;
+};
+
+// Blueprint adapter: every published event by name and topic. The event structs are native only, so the
+// payload is not passed; Blueprints read it from the publishing subsystem's own delegates or getters.
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTwinEventPublished, FName, EventName, FName, Topic);
+
+/**
+ * Typed native event bus for the framework's subsystems.
+ *
+ * Listeners subscribe to an event struct (see Core/TwinEvents.h) with an optional
+ * topic filter, a priority (higher first) and a delivery mode. Publishing an event
+ * nobody listens to is a single map lookup. Time spent in every listener is
+ * recorded; listeners slower than SlowListenerMs are logged once.
+ *
+ * The subsystems' dynamic multicast delegates remain the Blueprint surface next
+ * to the bus; C++ code should subscribe here instead.
+ */
+UCLASS()
+class TWINPLUSV2_API UEventBusSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Owner, when given, drops the listener once the object is gone
+    template <typename EventType>
+    FTwinEventHandle Subscribe(TFunction<void(const EventType&)> Listener, FName ListenerName,
+        FName Topic = NAME_None, int32 Priority = 0,
+        ETwinEventDelivery Delivery = ETwinEventDelivery::Immediate, const UObject* Owner = nullptr)
+    {
+        return AddListener(EventType::GetEventName(), ListenerName, Topic, Priority, Delivery, Owner,
+            [Listener = MoveTemp(Listener)](const void* Event)
+            {
+                Listener(*static_cast<const EventType*>(Event));
+            });
+    }
+
+    template <typename EventType, typename UserClass>
+    FTwinEventHandle Subscribe(UserClass* Object, void (UserClass::*Method)(const EventType&),
+        FName Topic = NAME_None, int32 Priority = 0, ETwinEventDelivery Delivery = ETwinEventDelivery::Immediate)
+    {
+        TWeakObjectPtr<UserClass> WeakObject(Object);
+        return AddListener(EventType::GetEventName(), Object->GetClass()->GetFName(), Topic, Priority, Delivery, Object,
+            [WeakObject, Method](const void* Event)
+            {
+                if (UserClass* Target = WeakObject.Get())
+                {
+                    (Target->*Method)(*static_cast<const EventType*>(Event));
+                }
+            });
+    }
+
+    void Unsubscribe(FTwinEventHandle& Handle);
+    void UnsubscribeAll(const UObject* Owner);
+
+    template <typename EventType>
+    void Publish(const EventType& Event)
+    {
+        FChannel* Channel = Channels.Find(EventType::GetEventName());
+        const bool bBlueprint = OnEventPublished.IsBound();
+        if (!Channel && !bBlueprint)
+        {
+            return;
+        }
+
+        const FName Topic = Event.GetTopic();
+        if (Channel)
+        {
+            // Queued first, the channel may be compacted away once the dispatch finished
+            if (Channel->NumBatched > 0)
+            {
+                Queue.Add({ EventType::GetEventName(), Topic, MakeShared<TQueuedEvent<EventType>>(Event) });
+            }
+            Dispatch(*Channel, EventType::GetEventName(), Topic, &Event, ETwinEventDelivery::Immediate);
+        }
+        if (bBlueprint)
+        {
+            OnEventPublished.Broadcast(EventType::GetEventName(), Topic);
+        }
+    }
+
+    // Whether Publish would reach anyone, a native listener or the Blueprint adapter
+    template <typename EventType>
+    bool HasListeners() const
+    {
+        return Channels.Contains(EventType::GetEventName()) || OnEventPublished.IsBound();
+    }
+
+    // Sorted by total time, slowest first
+    UFUNCTION(BlueprintCallable, Category = "Events")
+    TArray<FTwinEventListenerStats> GetListenerStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Events")
+    void ResetListenerStats();
+
+    UPROPERTY(BlueprintAssignable, Category = "Events")
+    FOnTwinEventPublished OnEventPublished;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Events", meta = (ClampMin = "0"))
+    float SlowListenerMs = 2.0f;
+
+private:
+    struct FQueuedEventBase
+    {
+        virtual ~FQueuedEventBase() = default;
+        virtual const void* Get() const = 0;
+    };
+
+    template <typename EventType>
+    struct TQueuedEvent : FQueuedEventBase
+    {
+        explicit TQueuedEvent(const EventType& InEvent) : Event(InEvent) {}
+        virtual const void* Get() const override { return &Event; }
+        EventType Event;
+    };
+
+    struct FQueuedEvent
+    {
+        FName EventName;
+        FName Topic;
+        TSharedPtr<FQueuedEventBase> Payload;
+    };
+
+    struct FListener
+    {
+        uint64 Id = 0;
+        FName ListenerName;
+        FName Topic;
+        int32 Priority = 0;
+        ETwinEventDelivery Delivery = ETwinEventDelivery::Immediate;
+        TWeakObjectPtr<const UObject> Owner;
+        bool bHasOwner = false;
+        TFunction<void(const void*)> Callback;
+
+        int32 Calls = 0;
+        double TotalSeconds = 0.0;
+        double MaxSeconds = 0.0;
+        bool bReportedSlow = false;
+    };
+
+    struct FChannel
+    {
+        // Highest priority first, equal priorities in subscription order
+        TArray<FListener> Listeners;
+        int32 NumBatched = 0;
+        bool bNeedsCompaction = false;
+    };
+
+    FTwinEventHandle AddListener(FName EventName, FName ListenerName, FName Topic, int32 Priority,
+        ETwinEventDelivery Delivery, const UObject* Owner, TFunction<void(const void*)> Callback);
+    void Dispatch(FChannel& Channel, FName EventName, FName Topic, const void* Event, ETwinEventDelivery Delivery);
+    void InsertListener(FName EventName, FListener&& Listener);
+    void RemoveListener(FChannel& Channel, FListener& Listener);
+    void ApplyPendingChanges();
+    void HandleEndFrame();
+
+    TMap<FName, FChannel> Channels;
+
+    // Channels are neither added nor reordered while a dispatch is running, subscriptions
+    // made by listeners are inserted and removed listeners compacted once it finished
+    int32 DispatchDepth = 0;
+    TArray<TPair<FName, FListener>> PendingListeners;
+    bool bNeedsCompaction = false;
+
+    TArray<FQueuedEvent> Queue;
+    FDelegateHandle EndFrameHandle;
+    uint64 NextListenerId = 1;
+};
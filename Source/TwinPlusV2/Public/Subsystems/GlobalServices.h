@@ -9,6 +9,8 @@ class UModeManagerSubsystem;
 class USceneManagerSubsystem;
 class UInputManagerSubsystem;
 class UTwinPluginManager;
+class UEventBusSubsystem;
+class UIconManagerSubsystem;
 
 UCLASS()
 class TWINPLUSV2_API UGlobalServices : public UObject
@@ -21,4 +23,6 @@ public:
     static USceneManagerSubsystem* GetSceneManager(const UObject* WorldContext);
     static UInputManagerSubsystem* GetInputManager(const UObject* WorldContext);
     static UTwinPluginManager* GetPluginManager(const UObject* WorldContext);
+    static UEventBusSubsystem* GetEventBus(const UObject* WorldContext);
+    static UIconManagerSubsystem* GetIconManager(const UObject* WorldContext);
 };
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Styling/SlateBrush.h"
+#include "Core/AppModes.h"
+#include "Subsystems/EventBusSubsystem.h"
+#include "IconManagerSubsystem.generated.h"
+
+class UImage;
+class UTexture2D;
+class UTextureRenderTarget2D;
+struct FStreamableHandle;
+
+DECLARE_DELEGATE_OneParam(FOnIconReady, const FSlateBrush&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnIconEvicted, const FSoftObjectPath&);
+
+UENUM(BlueprintType)
+enum class EIconAtlasEviction : uint8
+{
+    // The least recently requested icon no image shows makes room
+    LeastRecentlyUsed UMETA(DisplayName = "Least Recently Used"),
+    // A full atlas takes no more icons, they are drawn from their own texture
+    None              UMETA(DisplayName = "None")
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FIconAtlasStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 Cells = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 UsedCells = 0;
+
+    // Cells shown by images set through SetImageIcon, never evicted
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 PinnedCells = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 Requests = 0;
+
+    // Requests answered from the atlas without loading or drawing
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 AtlasHits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 Loads = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 PendingLoads = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 Packed = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 Evictions = 0;
+
+    // Icons that got a brush of their own texture because no cell was free
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int32 Overflows = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Icons")
+    int64 AtlasBytes = 0;
+};
+
+/**
+ * Streams tool and mode icons in the background and packs them into one atlas texture.
+ *
+ * Brushes handed out point into the atlas, so a palette of icons draws from a single
+ * texture and Slate batches it instead of binding one texture per icon. Source
+ * textures are released once packed. Icons are drawn into the atlas once per frame
+ * before Slate ticks, all icons that arrived that frame in one pass.
+ *
+ * A brush stays valid until its icon is evicted (see OnIconEvicted). Images set through
+ * SetImageIcon are tracked and keep their cells.
+ */
+UCLASS()
+class TWINPLUSV2_API UIconManagerSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Shows the icon on the image once it is in the atlas; hidden until then
+    UFUNCTION(BlueprintCallable, Category = "Icons")
+    void SetImageIcon(UImage* Image, TSoftObjectPtr<UTexture2D> Icon);
+
+    // Stops tracking the image and cancels its pending icon, e.g. when a list entry is released
+    UFUNCTION(BlueprintCallable, Category = "Icons")
+    void ClearImageIcon(UImage* Image);
+
+    // Brush of an icon already in the atlas
+    UFUNCTION(BlueprintCallable, Category = "Icons")
+    bool GetIconBrush(TSoftObjectPtr<UTexture2D> Icon, FSlateBrush& OutBrush);
+
+    // Calls back with the icon's brush once packed, right away if it already is. Returns 0
+    // when called back right away or for a null icon; a failed load never calls back.
+    int32 RequestIcon(const TSoftObjectPtr<UTexture2D>& Icon, FOnIconReady OnReady);
+    void CancelIconRequest(int32 RequestID);
+
+    // Streams and packs icons ahead of their first use
+    void PrewarmIcons(const TArray<FSoftObjectPath>& Icons);
+
+    // Mode icons for mode menus and the icons of the tools supported in Mode, done on every mode change
+    UFUNCTION(BlueprintCallable, Category = "Icons")
+    void PrewarmIconsForMode(EAppMode Mode);
+
+    // Drops every icon; the atlas is created again with the current settings on next use
+    UFUNCTION(BlueprintCallable, Category = "Icons")
+    void ClearAtlas();
+
+    UFUNCTION(BlueprintCallable, Category = "Icons")
+    FIconAtlasStats GetAtlasStats() const;
+
+    // Holders of brushes from GetIconBrush or RequestIcon request the icon again
+    FOnIconEvicted OnIconEvicted;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons", meta = (ClampMin = "64"))
+    int32 AtlasSize = 1024;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons", meta = (ClampMin = "8"))
+    int32 CellSize = 64;
+
+    // Transparent border inside each cell so filtering does not pick up neighbours
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons", meta = (ClampMin = "0"))
+    int32 CellPadding = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons")
+    EIconAtlasEviction Eviction = EIconAtlasEviction::LeastRecentlyUsed;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Icons")
+    bool bPrewarmModeIcons = true;
+
+private:
+    UPROPERTY()
+    TObjectPtr<UTextureRenderTarget2D> Atlas;
+
+    struct FAtlasCell
+    {
+        // None for a free cell
+        FSoftObjectPath Path;
+        uint64 LastUsedFrame = 0;
+    };
+    TArray<FAtlasCell> Cells;
+    TArray<int32> FreeCells;
+    TMap<FSoftObjectPath, int32> CellsByPath;
+
+    // Settings the atlas was created with
+    int32 CellsPerRow = 0;
+    int32 AtlasCellSize = 0;
+    int32 AtlasCellPadding = 0;
+
+    struct FIconRequest
+    {
+        FSoftObjectPath Path;
+        FOnIconReady OnReady;
+    };
+    TMap<int32, FIconRequest> Requests;
+    int32 LastRequestID = 0;
+
+    // Icons loading or waiting to be packed; the handle keeps the texture until then
+    struct FIconLoad
+    {
+        TSharedPtr<FStreamableHandle> Handle;
+        TArray<int32> RequestIDs;
+        bool bPrewarm = false;
+        bool bStreamed = false;
+    };
+    TMap<FSoftObjectPath, FIconLoad> Loads;
+    TArray<FSoftObjectPath> ReadyToPack;
+
+    struct FImageIcon
+    {
+        TWeakObjectPtr<UImage> Image;
+        FSoftObjectPath Path;
+        int32 RequestID = 0;
+    };
+    TMap<TObjectKey<UImage>, FImageIcon> ImageIcons;
+    // Images showing each icon, their cells are not evicted
+    TMap<FSoftObjectPath, int32> ImagePins;
+
+    FIconAtlasStats Stats;
+
+    UPROPERTY()
+    TObjectPtr<UEventBusSubsystem> EventBus;
+
+    FTwinEventHandle ModeChangedHandle;
+    FDelegateHandle SlatePreTickHandle;
+
+    // RequestID 0 for a prewarm
+    void StartLoad(const FSoftObjectPath& Path, int32 RequestID);
+    void StreamIcon(const FSoftObjectPath& Path, FIconLoad& Load);
+    void HandleIconLoaded(FSoftObjectPath Path);
+    void HandleSlatePreTick(float DeltaTime);
+    void HandleModeChanged(const FModeChangedEvent& Event);
+    void HandleImageIconReady(const FSlateBrush& Brush, TWeakObjectPtr<UImage> Image);
+    void PackReadyIcons();
+    void CompleteLoad(const FSoftObjectPath& Path, const FSlateBrush& Brush);
+    void DropLoad(const FSoftObjectPath& Path);
+
+    bool EnsureAtlas();
+    int32 AllocateCell(const FSoftObjectPath& Path);
+    void EvictCell(int32 Cell);
+    void PurgeStaleImages();
+    void UnpinImage(FImageIcon& ImageIcon);
+    FSlateBrush MakeCellBrush(int32 Cell) const;
+};
@@ -2,11 +2,35 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
 #include "Core/AppModes.h"
+#include "Core/UILayer.h"
 #include "DataAssets/AppModeRegistry.h"
+#include "Subsystems/SceneManagerSubsystem.h"
 #include "ModeManagerSubsystem.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnModeChanged, EAppMode, NewMode);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnModeTransitionStarted, EAppMode, FromMode, EAppMode, ToMode);
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FModeAssetReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Mode")
+    EAppMode Mode = EAppMode::None;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Mode")
+    int32 Handles = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Mode")
+    int32 Assets = 0;
+
+    // Estimated resource size of the loaded assets, shared assets count for every mode holding them
+    UPROPERTY(BlueprintReadOnly, Category = "Mode")
+    int64 Bytes = 0;
+};
 
 UCLASS()
 class TWINPLUSV2_API UModeManagerSubsystem : public UGameInstanceSubsystem
@@ -15,15 +39,81 @@ class TWINPLUSV2_API UModeManagerSubsystem : public UGameInstanceSubsystem
 
 public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
 
+    // Prepares the mode (level, UI and tool assets streamed in) and commits it from the core
+    // ticker once everything is resident, at the earliest on the next tick. Calls within a
+    // frame collapse: a newer SetMode replaces a transition still preparing.
     UFUNCTION(BlueprintCallable, Category="Mode")
     void SetMode(EAppMode Mode);
 
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Mode")
+    EAppMode GetCurrentMode() const { return CurrentMode; }
+
+    // None when no transition is preparing
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Mode")
+    EAppMode GetPendingMode() const { return PendingMode; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Mode")
+    bool IsTransitioning() const { return PendingMode != EAppMode::None; }
+
+    // 0..1 while preparing
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Mode")
+    float GetTransitionProgress() const;
+
     const FAppModeEntry* GetCurrentModeEntry() const;
 
+    const UAppModeRegistry* GetModeRegistry() const { return ModeRegistry; }
+
+    // Mode-scoped loads: the handle is kept until the mode is left, then released with
+    // every other handle of that mode. Loads made while no mode is set end with the first mode.
+    UObject* LoadForMode(const FSoftObjectPath& Path);
+    TSharedPtr<FStreamableHandle> RequestAsyncLoadForMode(const TArray<FSoftObjectPath>& Paths, FStreamableDelegate OnLoaded = FStreamableDelegate());
+    void AddModeHandle(EAppMode Mode, TSharedPtr<FStreamableHandle> Handle);
+
+    // Background mode-scoped load of one asset. Requests for a path already in flight share
+    // its load, so UI and tool code can ask for the same class. Resident assets call back
+    // right away; a load that fails or is cancelled by leaving the mode calls back with null.
+    void LoadForModeAsync(const FSoftObjectPath& Path, TFunction<void(UObject*)> OnLoaded);
+
+    template <typename T>
+    UClass* LoadClassForMode(const TSoftClassPtr<T>& Class)
+    {
+        return Cast<UClass>(LoadForMode(Class.ToSoftObjectPath()));
+    }
+
+    UFUNCTION(BlueprintCallable, Category = "Mode")
+    TArray<FModeAssetReport> GetModeAssetReport() const;
+
     UPROPERTY(BlueprintAssignable)
     FOnModeChanged OnModeChanged;
 
+    UPROPERTY(BlueprintAssignable)
+    FOnModeTransitionStarted OnModeTransitionStarted;
+
+    // Stream the target mode's assets before committing, off = commit on the next tick
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mode|Transition")
+    bool bPrewarmTransitions = true;
+
+    // UIRegistry entry shown while a transition prepares, None for no loading UI
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mode|Transition")
+    FName LoadingUIName;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mode|Transition")
+    EUILayer LoadingUILayer = EUILayer::Popup;
+
+    // Transitions that are ready sooner never show the loading UI
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mode|Transition", meta = (ClampMin = "0"))
+    float LoadingUIDelay = 0.25f;
+
+    // Commit anyway after this long, with whatever finished loading
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mode|Transition", meta = (ClampMin = "0"))
+    float MaxPrepareSeconds = 15.0f;
+
+    // Request a garbage collection after the old mode's handles were released
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Mode|Transition")
+    bool bCollectGarbageOnModeExit = true;
+
 private:
     UPROPERTY()
     TObjectPtr<UAppModeRegistry> ModeRegistry;
@@ -31,5 +121,37 @@ private:
     EAppMode CurrentMode = EAppMode::None;
     TMap<EAppMode, TArray<EAppMode>> AllowedTransitions;
 
+    // Transition
+    EAppMode PendingMode = EAppMode::None;
+    TArray<TSharedPtr<FStreamableHandle>> PrepareHandles;
+    FSceneRequestHandle PrepareSceneRequest;
+    int32 PrepareStage = 0;
+    double PrepareStartTime = 0.0;
+    bool bLoadingUIShown = false;
+    FTSTicker::FDelegateHandle TransitionTickerHandle;
+
+    // Prewarmed and mode-scoped loads, released when their mode is left
+    TMap<EAppMode, TArray<TSharedPtr<FStreamableHandle>>> ModeHandles;
+    // Paths requested by the handles in ModeHandles, a second handle for them is released right away
+    TMap<EAppMode, TSet<FSoftObjectPath>> HeldPaths;
+
     bool CanTransition(EAppMode NewMode) const;
+    void BeginPrepare(EAppMode Mode);
+    bool RequestStage(EAppMode Mode);
+    void GatherModeAssets(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths);
+    bool IsPrepareComplete() const;
+    bool TickTransition(float DeltaTime);
+    void CommitMode();
+    void CancelPrepare();
+    void HideLoadingUI();
+    int32 ReleaseModeHandles(EAppMode Mode);
+    void HandleAsyncLoadFinished(FSoftObjectPath Path);
+
+    struct FPendingModeLoad
+    {
+        TSharedPtr<FStreamableHandle> Handle;
+        TArray<TFunction<void(UObject*)>> Callbacks;
+    };
+    TMap<FSoftObjectPath, FPendingModeLoad> PendingLoads;
+    int32 SharedLoads = 0;
 };
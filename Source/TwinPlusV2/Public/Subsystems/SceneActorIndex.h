@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "SceneActorIndex.generated.h"
+
+class AActor;
+class ULevel;
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FSceneActorIndexStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 IndexedActors = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 IndexedLevels = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 Classes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 Tags = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 MetadataValues = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int64 MemoryBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 Updates = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float LastUpdateMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float MaxUpdateMs = 0.0f;
+};
+
+/**
+ * Lookup tables over the actors of the loaded scenes, maintained per level as
+ * levels are added to and removed from the world instead of scanning it per query.
+ *
+ * Metadata is read from actor tags of the form "<MetadataKey>=<Value>".
+ * Tags changed after an actor was indexed need ReindexActor.
+ */
+class TWINPLUSV2_API FSceneActorIndex
+{
+public:
+    void SetMetadataKey(FName InMetadataKey) { MetadataKey = InMetadataKey; }
+
+    // Return the number of actors added / removed
+    int32 AddLevel(ULevel* Level, FName SceneName);
+    int32 RemoveLevel(ULevel* Level);
+    bool AddActor(AActor* Actor);
+    bool RemoveActor(AActor* Actor);
+    void Reset();
+
+    FName GetSceneForLevel(const ULevel* Level) const { return LevelScenes.FindRef(Level); }
+    bool IsLevelIndexed(const ULevel* Level) const { return LevelActors.Contains(Level); }
+
+    // Includes subclasses
+    void FindByClass(const UClass* Class, TArray<AActor*>& OutActors) const;
+    void FindByTag(FName Tag, TArray<AActor*>& OutActors) const;
+    void FindByScene(FName SceneName, TArray<AActor*>& OutActors) const;
+    void FindByMetadata(const FString& Value, TArray<AActor*>& OutActors) const;
+    AActor* FindFirstByMetadata(const FString& Value) const;
+
+    FSceneActorIndexStats GetStats() const;
+
+private:
+    struct FIndexedActor
+    {
+        TObjectKey<UClass> Class;
+        TObjectKey<ULevel> Level;
+        FName SceneName;
+        TArray<FName> Tags;
+        FString MetadataValue;
+    };
+
+    using FActorSet = TSet<TObjectKey<AActor>>;
+
+    bool AddActorInternal(AActor* Actor, FName SceneName);
+    void RemoveActorInternal(const TObjectKey<AActor>& Key);
+    void RecordUpdate(double StartTime);
+    static void Resolve(const FActorSet* Set, TArray<AActor*>& OutActors);
+
+    FName MetadataKey;
+
+    TMap<TObjectKey<AActor>, FIndexedActor> Actors;
+    TMap<TObjectKey<ULevel>, FActorSet> LevelActors;
+    TMap<TObjectKey<ULevel>, FName> LevelScenes;
+    TMap<TObjectKey<UClass>, FActorSet> ByClass;
+    TMap<FName, FActorSet> ByTag;
+    TMap<FName, FActorSet> ByScene;
+    TMap<FString, FActorSet> ByMetadata;
+
+    // Query class -> indexed classes deriving from it, dropped when a new class is indexed
+    mutable TMap<TObjectKey<UClass>, TArray<TObjectKey<UClass>>> ClassQueryCache;
+
+    int32 Updates = 0;
+    double LastUpdateSeconds = 0.0;
+    double MaxUpdateSeconds = 0.0;
+};
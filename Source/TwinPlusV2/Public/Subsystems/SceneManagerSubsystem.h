@@ -2,10 +2,172 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
 #include "DataAssets/SceneRegistry.h"
+#include "Subsystems/SceneStateSnapshot.h"
+#include "Subsystems/SceneActorIndex.h"
+#include "Core/TwinEvents.h"
+#include "Async/Future.h"
 #include "SceneManagerSubsystem.generated.h"
 
+class ULevelStreaming;
+class ULevel;
+class AActor;
+struct FActorsInitializedParams;
+
+UENUM(BlueprintType)
+enum class ESceneRequestType : uint8
+{
+    Load        UMETA(DisplayName = "Load"),
+    Unload      UMETA(DisplayName = "Unload"),
+    Hide        UMETA(DisplayName = "Hide")
+};
+
+UENUM(BlueprintType)
+enum class ESceneRequestState : uint8
+{
+    None            UMETA(DisplayName = "None"),
+    Loading         UMETA(DisplayName = "Loading"),
+    MakingVisible   UMETA(DisplayName = "Making Visible"),
+    Unloading       UMETA(DisplayName = "Unloading"),
+    Hiding          UMETA(DisplayName = "Hiding"),
+    Completed       UMETA(DisplayName = "Completed"),
+    Failed          UMETA(DisplayName = "Failed"),
+    Cancelled       UMETA(DisplayName = "Cancelled")
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FSceneRequestHandle
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 RequestId = INDEX_NONE;
+
+    bool IsValid() const { return RequestId != INDEX_NONE; }
+    void Reset() { RequestId = INDEX_NONE; }
+
+    bool operator==(const FSceneRequestHandle& Other) const { return RequestId == Other.RequestId; }
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FScenePhaseTimings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    FName SceneName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    ESceneRequestType Type = ESceneRequestType::Load;
+
+    // Load: request to level loaded. Unload: request to level hidden.
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float FirstPhaseSeconds = 0.0f;
+
+    // Load: loaded to visible. Unload: hidden to unloaded.
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float SecondPhaseSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float TotalSeconds = 0.0f;
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FSceneResidencyStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 Hits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 Misses = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float HitRate = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 Evictions = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 ResidentScenes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 CachedScenes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int64 ResidentBytes = 0;
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FSceneSwitchStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 Requested = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 TransitionsStarted = 0;
+
+    // Targets replaced by a newer SwitchScene before they started
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 Skipped = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 LoadsAborted = 0;
+};
+
+// One completed scene load, phases are seconds since the request
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FSceneLoadTelemetry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    FName SceneName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 RequestId = 0;
+
+    // Seconds since the subsystem started
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float RequestedAt = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float PackageLoadedSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float LevelAddedSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float VisibleSeconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float ListenersDoneSeconds = 0.0f;
+
+    // Time spent inside OnSceneLoaded / OnScenePreloaded handlers
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    float ListenerSeconds = 0.0f;
+
+    // Size of the level package on disk, 0 when it cannot be resolved (e.g. IoStore)
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int64 PackageBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int64 ResidentBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    int32 ActorCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Scene")
+    bool bPreload = false;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSceneEvent, FName, SceneName);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSceneRequestCompleted, FSceneRequestHandle, Handle, FName, SceneName, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnActorIndexChanged, FName, SceneName, int32, ActorsAdded, int32, ActorsRemoved);
 
 UCLASS()
 class TWINPLUSV2_API USceneManagerSubsystem : public UGameInstanceSubsystem
@@ -14,36 +176,362 @@ class TWINPLUSV2_API USceneManagerSubsystem : public UGameInstanceSubsystem
 
 public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
 
     UFUNCTION(BlueprintCallable, Category="Scene")
-    void LoadScene(FName SceneName, bool bMakeVisible = true);
+    FSceneRequestHandle LoadScene(FName SceneName, bool bMakeVisible = true);
 
     UFUNCTION(BlueprintCallable, Category="Scene")
-    void UnloadScene(FName SceneName);
+    FSceneRequestHandle UnloadScene(FName SceneName);
 
+    // Latest wins: at most one transition runs, intermediate targets are skipped or aborted
     UFUNCTION(BlueprintCallable, Category="Scene")
     void SwitchScene(FName SceneName);
 
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene")
+    FSceneSwitchStats GetSwitchStats() const { return SwitchStats; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene")
+    TArray<FName> GetRegisteredSceneNames() const;
+
+    // Streams a scene in with visibility off so a later SwitchScene only has to show it
+    UFUNCTION(BlueprintCallable, Category="Scene")
+    FSceneRequestHandle PreloadScene(FName SceneName);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene")
+    bool IsScenePreloaded(FName SceneName) const { return PreloadedScenes.Contains(SceneName); }
+
+    // Residency Cache - pinned scenes are never evicted
+    UFUNCTION(BlueprintCallable, Category="Scene|Residency")
+    void PinScene(FName SceneName, bool bPinned = true);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene|Residency")
+    bool IsScenePinned(FName SceneName) const { return PinnedScenes.Contains(SceneName); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene|Residency")
+    FSceneResidencyStats GetResidencyStats() const;
+
+    // Spatial Streaming - loads FSceneEntry cells around the player camera (ATwinCameraPawn)
+    UFUNCTION(BlueprintCallable, Category="Scene|Spatial")
+    void SetSpatialStreamingEnabled(bool bEnabled);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene|Spatial")
+    bool IsSpatialStreamingEnabled() const { return SpatialTickerHandle.IsValid(); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene|Spatial")
+    TArray<FName> GetResidentCells() const { return ResidentCells.Array(); }
+
+    // Scene State Snapshots - SaveGame properties of a scene's actors and components
+    // Time sliced over the next frames, OnSceneStateCaptured fires when done
+    UFUNCTION(BlueprintCallable, Category="Scene|Snapshot")
+    bool CaptureSceneState(FName SceneName);
+
+    // Applies the last snapshot to the loaded scene, only properties that differ are written
+    UFUNCTION(BlueprintCallable, Category="Scene|Snapshot")
+    bool RestoreSceneState(FName SceneName);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene|Snapshot")
+    bool HasSceneSnapshot(FName SceneName) const { return Snapshots.Contains(SceneName); }
+
+    UFUNCTION(BlueprintCallable, Category="Scene|Snapshot")
+    void DiscardSceneSnapshot(FName SceneName);
+
+    // Actor Index - lookups maintained as levels are added and removed, use instead of GetAllActorsOfClass
+    UFUNCTION(BlueprintCallable, Category="Scene|ActorIndex", meta = (DeterminesOutputType = "ActorClass"))
+    TArray<AActor*> FindActorsByClass(TSubclassOf<AActor> ActorClass) const;
+
+    UFUNCTION(BlueprintCallable, Category="Scene|ActorIndex")
+    TArray<AActor*> FindActorsByTag(FName Tag) const;
+
+    // NAME_None is the persistent level
+    UFUNCTION(BlueprintCallable, Category="Scene|ActorIndex")
+    TArray<AActor*> FindActorsInScene(FName SceneName) const;
+
+    UFUNCTION(BlueprintCallable, Category="Scene|ActorIndex")
+    TArray<AActor*> FindActorsByMetadata(const FString& Value) const;
+
+    UFUNCTION(BlueprintCallable, Category="Scene|ActorIndex")
+    AActor* FindActorByMetadata(const FString& Value) const;
+
+    // Call after changing an actor's tags at runtime
+    UFUNCTION(BlueprintCallable, Category="Scene|ActorIndex")
+    void ReindexActor(AActor* Actor);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene|ActorIndex")
+    FSceneActorIndexStats GetActorIndexStats() const { return ActorIndex.GetStats(); }
+
+    // Native queries without the array copy
+    const FSceneActorIndex& GetActorIndex() const { return ActorIndex; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene")
+    ESceneRequestState GetSceneRequestState(FSceneRequestHandle Handle) const;
+
+    // 0..1, package load progress while loading
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene")
+    float GetSceneRequestProgress(FSceneRequestHandle Handle) const;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene")
+    bool GetLastSceneTimings(FName SceneName, ESceneRequestType Type, FScenePhaseTimings& OutTimings) const;
+
+    // Completed loads in order, oldest first
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category="Scene|Telemetry")
+    const TArray<FSceneLoadTelemetry>& GetSceneTimeline() const { return SceneTimeline; }
+
+    // Writes the timeline as CSV, one row per load
+    UFUNCTION(BlueprintCallable, Category="Scene|Telemetry")
+    bool ExportSceneTimelineCSV(const FString& FilePath) const;
+
     FName GetCurrentScene() const { return CurrentScene; }
 
+    // Registered scene streaming the given level package, NAME_None if there is none
+    FName FindSceneByLevel(FName LevelPackageName) const;
+
+    // Fired once the level is resident (and visible, if requested)
     UPROPERTY(BlueprintAssignable, Category="Scene")
     FOnSceneEvent OnSceneLoaded;
 
+    // Fired once the level has actually been removed from the world
     UPROPERTY(BlueprintAssignable, Category="Scene")
     FOnSceneEvent OnSceneUnloaded;
 
+    UPROPERTY(BlueprintAssignable, Category="Scene")
+    FOnSceneRequestCompleted OnSceneRequestCompleted;
+
+    // Fired once a preloaded scene is resident and hidden
+    UPROPERTY(BlueprintAssignable, Category="Scene")
+    FOnSceneEvent OnScenePreloaded;
+
+    // Fired when a scene is switched away from but kept resident in the cache
+    UPROPERTY(BlueprintAssignable, Category="Scene")
+    FOnSceneEvent OnSceneHidden;
+
+    UPROPERTY(BlueprintAssignable, Category="Scene|Snapshot")
+    FOnSceneEvent OnSceneStateCaptured;
+
+    UPROPERTY(BlueprintAssignable, Category="Scene|Snapshot")
+    FOnSceneEvent OnSceneStateRestored;
+
+    // Fired after a level or a single actor was added to or removed from the actor index
+    UPROPERTY(BlueprintAssignable, Category="Scene|ActorIndex")
+    FOnActorIndexChanged OnActorIndexChanged;
+
+    // Start loading the next scene while the previous one is still unloading
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene")
+    bool bOverlapSceneSwitch = true;
+
+    // Preload FSceneEntry::AdjacentScenes of the current scene
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene")
+    bool bPredictivePreload = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene", meta = (ClampMin = "0"))
+    int32 MaxPredictivePreloads = 2;
+
+    // Memory kept for resident scenes, hidden ones are evicted LRU-first above it. 0 unloads on every switch.
+    // Spatial cells count against CellBudgetMB instead.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Residency", meta = (ClampMin = "0"))
+    int32 ResidencyBudgetMB = 2048;
+
+    // Below this much free physical memory all unpinned hidden scenes are shed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Residency", meta = (ClampMin = "0"))
+    int32 MinFreePhysicalMB = 1024;
+
+    // Cells closer than this to the (predicted) camera are loaded
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Spatial", meta = (ClampMin = "0"))
+    float CellLoadRadius = 20000.0f;
+
+    // Resident cells are only dropped beyond this distance, the gap to CellLoadRadius is the hysteresis
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Spatial", meta = (ClampMin = "0"))
+    float CellUnloadRadius = 30000.0f;
+
+    // How far ahead along the camera velocity cells are requested
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Spatial", meta = (ClampMin = "0"))
+    float VelocityLookaheadSeconds = 2.0f;
+
+    // 0 orders cells by distance only, 1 strongly favours cells in front of the camera
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Spatial", meta = (ClampMin = "0", ClampMax = "1"))
+    float ViewDirectionWeight = 0.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Spatial", meta = (ClampMin = "1"))
+    int32 MaxConcurrentCellLoads = 2;
+
+    // Hard cap on loaded cells, the nearest win
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Spatial", meta = (ClampMin = "1"))
+    int32 MaxResidentCells = 16;
+
+    // Memory for loaded cells, the nearest that fit win. 0 for no limit besides MaxResidentCells.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Spatial", meta = (ClampMin = "0"))
+    int32 CellBudgetMB = 1024;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Spatial", meta = (ClampMin = "0"))
+    float SpatialUpdateInterval = 0.1f;
+
+    // Snapshot a scene's state before it is unloaded; the level is hidden right away and unloaded once the
+    // time sliced capture is done
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Snapshot")
+    bool bSnapshotOnUnload = true;
+
+    // Restore the snapshot when the scene is loaded again from its package
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Snapshot")
+    bool bRestoreSnapshotOnLoad = true;
+
+    // Game thread time per frame for CaptureSceneState
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Snapshot", meta = (ClampMin = "0.1"))
+    float SnapshotTimeSliceMs = 2.0f;
+
+    // Beyond this the oldest snapshots are written to Saved/SceneSnapshots/<instance> and dropped from memory
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Snapshot", meta = (ClampMin = "0"))
+    int32 SnapshotMemoryBudgetMB = 64;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scene|Snapshot")
+    bool bSpillSnapshotsToDisk = true;
+
+    // Actor tags "<Key>=<Value>" are indexed as metadata, read when the world's actors are initialized
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Scene|ActorIndex")
+    FName ActorMetadataKey = TEXT("TwinId");
+
 private:
+    struct FSceneRequest
+    {
+        int32 Id = INDEX_NONE;
+        FName SceneName;
+        ESceneRequestType Type = ESceneRequestType::Load;
+        ESceneRequestState State = ESceneRequestState::None;
+        bool bMakeVisible = true;
+        bool bPreload = false;
+        bool bSpatialCell = false;
+        // Level was already loaded when the request started
+        bool bWasResident = false;
+        // Unload held back until the scene's state snapshot is captured
+        bool bAwaitingSnapshot = false;
+        TWeakObjectPtr<ULevelStreaming> StreamingLevel;
+
+        double RequestedTime = 0.0;
+        double FirstPhaseTime = 0.0;
+        double LevelAddedTime = 0.0;
+        double CompletedTime = 0.0;
+    };
+
     UPROPERTY()
     TObjectPtr<USceneRegistry> SceneRegistry;
 
     UPROPERTY()
     FName CurrentScene = NAME_None;
 
-    TQueue<FName> SceneQueue;
+    // Switch bookkeeping
+    FName PendingSwitchTarget = NAME_None;
+    FSceneRequestHandle PendingSwitchUnload;
+    FSceneRequestHandle PendingSwitchLoad;
+    FName SwitchLoadScene = NAME_None;
+    FName DeferredSwitchTarget = NAME_None;
+    FSceneSwitchStats SwitchStats;
+
+    // Resident but hidden, ready for an instant switch
+    TSet<FName> PreloadedScenes;
+    TSet<FName> PredictedScenes;
+
+    // Residency cache: hidden scenes in LRU order (oldest first) and measured size of everything resident
+    TArray<FName> ResidentLRU;
+    TMap<FName, int64> ResidentBytes;
+    TSet<FName> PinnedScenes;
+    int32 CacheHits = 0;
+    int32 CacheMisses = 0;
+    int32 CacheEvictions = 0;
+    FDelegateHandle MemoryTrimHandle;
 
-    void ProcessNextSceneInQueue();
+    // Spatial streaming
+    TSet<FName> ResidentCells;
+    TMap<FName, FSceneRequestHandle> CellLoads;
+    TSet<FName> UnavailableCells;
+    // Last measured size of every cell loaded so far, cells not yet loaded use their estimate
+    TMap<FName, int64> CellSizes;
+
+    // Snapshots
+    struct FSnapshotCapture
+    {
+        TWeakObjectPtr<ULevel> Level;
+        TArray<TWeakObjectPtr<UObject>> Objects;
+        int32 NextObject = 0;
+        int32 NumObjects = 0;
+        int32 NumProperties = 0;
+        TArray<uint8> RawData;
+    };
+    TMap<FName, TSharedPtr<FSnapshotCapture>> SnapshotCaptures;
+    TMap<FName, TSharedPtr<FSceneStateSnapshot>> Snapshots;
+    TMap<FName, TFuture<TArray<uint8>>> SnapshotPrefetches;
+    FTSTicker::FDelegateHandle SnapshotTickerHandle;
+    // Own directory under Saved/SceneSnapshots, deleted with the subsystem
+    FString SnapshotSpillDir;
+
+    // Actor index
+    FSceneActorIndex ActorIndex;
+    TWeakObjectPtr<UWorld> IndexedWorld;
+    FDelegateHandle LevelRemovedHandle;
+    FDelegateHandle WorldActorsInitializedHandle;
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle ActorDestroyedHandle;
+    FTSTicker::FDelegateHandle SpatialTickerHandle;
+
+    int32 NextRequestId = 0;
+    TMap<int32, FSceneRequest> ActiveRequests;
+    TMap<int32, ESceneRequestState> FinishedRequests;
+    TMap<FName, FScenePhaseTimings> LastLoadTimings;
+    TMap<FName, FScenePhaseTimings> LastUnloadTimings;
+
+    // Telemetry
+    TArray<FSceneLoadTelemetry> SceneTimeline;
+    // Level package size on disk per scene, resolved off the game thread on the scene's first load
+    TMap<FName, int64> PackageSizes;
+    double TelemetryStartTime = 0.0;
+    FDelegateHandle LevelAddedHandle;
+
+    FTSTicker::FDelegateHandle PollTickerHandle;
+
+    bool IsSwitchInFlight() const;
+    void StartNextSwitch();
+    void AbortSwitchLoad();
     const FSceneEntry* FindSceneEntry(FName SceneName) const;
+    ULevelStreaming* FindStreamingLevel(const FSceneEntry& Entry) const;
+
+    FSceneRequestHandle StartRequest(FName SceneName, ESceneRequestType Type, bool bMakeVisible, bool bPreload = false, bool bSpatialCell = false);
+    void CancelRequestsForScene(FName SceneName);
+    void UpdateRequests();
+    bool UpdateRequest(FSceneRequest& Request);
+    void FinishRequest(int32 RequestId, ESceneRequestState FinalState);
+    void OnSwitchRequestFinished(int32 RequestId);
+    void FlushVisibility();
+    FSceneRequestHandle RetireScene(FName SceneName);
+    int64 MeasureSceneBytes(FName SceneName, const ULevelStreaming* Level) const;
+    void EnforceResidencyBudget();
+    void ShedCachedScenes();
+    void EvictScene(FName SceneName);
+    bool HasActiveRequest(FName SceneName) const;
+    bool HasActiveUnload(FName SceneName) const;
+    void HandleMemoryTrim();
+    void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+    TSharedPtr<FSnapshotCapture> BeginSnapshotCapture(ULevel* Level) const;
+    bool StepSnapshotCapture(FSnapshotCapture& Capture, double Deadline) const;
+    void FinishSnapshotCapture(FName SceneName, FSnapshotCapture& Capture);
+    void ReleaseSnapshotUnload(FName SceneName);
+    bool TickSnapshotCaptures(float DeltaTime);
+    void PrefetchSnapshot(FName SceneName);
+    void EnforceSnapshotBudget();
+    FName FindSceneForLevel(const ULevel* Level) const;
+    void BindActorIndex(UWorld* World);
+    void UnbindActorIndex();
+    void HandleWorldActorsInitialized(const FActorsInitializedParams& Params);
+    void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+    void HandleActorSpawned(AActor* Actor);
+    void HandleActorDestroyed(AActor* Actor);
+    void PublishSceneEvent(ESceneEventType Type, FName SceneName);
+    void PublishActorIndexChanged(FName SceneName, int32 ActorsAdded, int32 ActorsRemoved);
+    void RecordLoadTelemetry(const FSceneRequest& Request, double ListenerSeconds);
+    void ResolvePackageSize(FName SceneName, const FSceneEntry& Entry);
+    bool UpdateSpatialStreaming(float DeltaTime);
+    bool GetStreamingViewPoint(FVector& OutLocation, FVector& OutForward, FVector& OutVelocity) const;
+    void UpdatePredictivePreloads(FName NewCurrentScene);
+    void EnsurePolling();
+    bool PollRequests(float DeltaTime);
 
     UFUNCTION()
-    void OnPreviousSceneUnloaded(FName UnloadedScene);
+    void HandleStreamingLevelChanged();
 };
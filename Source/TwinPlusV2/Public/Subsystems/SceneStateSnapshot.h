@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ULevel;
+
+// SaveGame-flagged state of one scene, as a zlib compressed record stream
+struct TWINPLUSV2_API FSceneStateSnapshot
+{
+    FName SceneName;
+    double CaptureTime = 0.0;
+    int32 NumObjects = 0;
+    int32 NumProperties = 0;
+    int32 RawSize = 0;
+
+    // Uncompressed stream, only held until background compression finishes
+    TArray<uint8> RawData;
+
+    // Empty while spilled to disk
+    TArray<uint8> CompressedData;
+    FString SpillPath;
+
+    bool IsSpilled() const { return RawData.IsEmpty() && CompressedData.IsEmpty() && !SpillPath.IsEmpty(); }
+    int64 GetMemoryBytes() const { return RawData.GetAllocatedSize() + CompressedData.GetAllocatedSize(); }
+};
+
+struct TWINPLUSV2_API FSceneStateRestoreStats
+{
+    int32 ObjectsRestored = 0;
+    int32 ObjectsMissing = 0;
+    int32 ActorsRespawned = 0;
+    int32 PropertiesApplied = 0;
+    int32 PropertiesUnchanged = 0;
+    double Seconds = 0.0;
+};
+
+namespace TwinSceneState
+{
+    // Actors of the level and their components that have at least one SaveGame property
+    TWINPLUSV2_API void GatherObjects(const ULevel* Level, TArray<UObject*>& OutObjects);
+
+    // Appends one record holding every SaveGame property of Object, returns the property count
+    TWINPLUSV2_API int32 WriteObject(FArchive& Writer, UObject* Object);
+
+    // Applies a record stream to the level. Properties whose serialized value already
+    // matches are left alone; runtime-spawned actors that are gone are spawned again.
+    TWINPLUSV2_API FSceneStateRestoreStats Restore(ULevel* Level, const TArray<uint8>& RawData);
+
+    TWINPLUSV2_API bool Compress(const TArray<uint8>& RawData, TArray<uint8>& OutCompressed);
+    TWINPLUSV2_API bool Decompress(const TArray<uint8>& Compressed, int32 RawSize, TArray<uint8>& OutRawData);
+}
@@ -4,12 +4,91 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Core/UILayer.h"
 #include "DataAssets/UIRegistry.h"
+#include "Subsystems/EventBusSubsystem.h"
+#include "UIRootWidget.h"
 #include "UIManagerSubsystem.generated.h"
 
 class UUserWidget;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUIPushed, FName, UIName, EUILayer, Layer, UUserWidget*, Widget);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUIPopped, EUILayer, Layer, UUserWidget*, Widget);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUIChangesApplied, int32, Pushed, int32, Popped, int32, Cancelled);
+
+UENUM(BlueprintType)
+enum class EUIWidgetOwnership : uint8
+{
+    // Only taken off its layer when removed, the caller can push it again
+    Caller  UMETA(DisplayName = "Caller"),
+    // Goes to the pool of the name it was pushed as when removed, or is dropped
+    Manager UMETA(DisplayName = "Manager")
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FUIWidgetPoolStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "UI")
+    int32 Hits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "UI")
+    int32 Misses = 0;
+
+    // Popped widgets that could not be kept (pool full, over budget or pooling off)
+    UPROPERTY(BlueprintReadOnly, Category = "UI")
+    int32 Discarded = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "UI")
+    int32 PooledWidgets = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "UI")
+    int64 PooledBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "UI")
+    float HitRate = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "UI")
+    float AverageCreateMs = 0.0f;
+
+    // Hits times the average creation time
+    UPROPERTY(BlueprintReadOnly, Category = "UI")
+    float EstimatedSavedMs = 0.0f;
+};
+
+USTRUCT()
+struct FUIWidgetPool
+{
+    GENERATED_BODY()
+
+    // Oldest first
+    UPROPERTY()
+    TArray<TObjectPtr<UUserWidget>> Widgets;
+
+    TArray<int64> WidgetBytes;
+};
+
+USTRUCT()
+struct FUILayerStack
+{
+    GENERATED_BODY()
+
+    // Bottom to top
+    UPROPERTY()
+    TArray<TObjectPtr<UUserWidget>> Widgets;
+
+    // Registry entry each widget was pushed from
+    TArray<FName> Names;
+};
+
+/**
+ * Widgets live in per-layer stacks on one root widget (see UUIRootWidget) instead of
+ * being added to the viewport one by one. A push goes on top of its layer, a pop
+ * removes the top and shows the widget below again.
+ *
+ * Pushes and pops are recorded and applied together, once per frame before Slate
+ * ticks or at the end of a transaction. A pop undoing a push of the same batch
+ * cancels both, so the viewport only sees the net change.
+ */
 
 UCLASS()
 class TWINPLUSV2_API UUIManagerSubsystem : public UGameInstanceSubsystem
@@ -21,24 +100,201 @@ public:
 
 virtual void Deinitialize() override;   
 
+    // Pushes on top of the layer's stack
     UFUNCTION(BlueprintCallable, Category = "UI")
     void PushUI(FName UIName, EUILayer Layer);
 
+    // Shows the entry once its widget class has loaded in the background. Until then the
+    // placeholder is shown on the layer if its class is resident. A later push or pop on
+    // the layer replaces the pending one.
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    void PushUIAsync(FName UIName, EUILayer Layer);
+
+    // Pushes a widget that already exists instead of creating one from the registry.
+    // UIName is passed to listeners and picks the pool of manager owned widgets. A widget
+    // already on a layer moves to the top of Layer.
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    void PushWidget(UUserWidget* Widget, EUILayer Layer, FName UIName = NAME_None,
+        EUIWidgetOwnership Ownership = EUIWidgetOwnership::Caller);
+
+    // Removes the widget from whichever layer holds it
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    bool RemoveWidget(UUserWidget* Widget);
+
+    // Removes the top widget of the layer, or cancels the layer's pending PushUIAsync
     UFUNCTION(BlueprintCallable, Category = "UI")
     void PopUI(EUILayer Layer);
 
+    // Removes the topmost widget pushed from UIName, wherever it is in the stack
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    bool RemoveUI(FName UIName, EUILayer Layer);
+
     UFUNCTION(BlueprintCallable, Category = "UI")
     void PopAllUI();
 
+    // Changes until the matching end are applied as one batch. Transactions nest.
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    void BeginUITransaction();
+
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    void EndUITransaction();
+
+    // Applies recorded changes now instead of before the next Slate tick
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    void FlushUIChanges();
+
+    // Off applies changes outside transactions right away
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
+    bool bBatchUIChanges = true;
+
+    // Reflects applied changes only, see FlushUIChanges
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UI")
+    UUserWidget* GetTopWidget(EUILayer Layer) const;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UI")
+    int32 GetLayerDepth(EUILayer Layer) const;
+
+    // Hidden layers keep their stacks but are collapsed, they cost no layout or paint
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    void SetLayerVisible(EUILayer Layer, bool bVisible);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UI")
+    bool IsLayerVisible(EUILayer Layer) const;
+
+    // Created on first use and again for every new world
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    UUIRootWidget* GetRootWidget();
+
+    // Subclass to set caching per layer
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
+    TSubclassOf<UUIRootWidget> RootWidgetClass;
+
+    // Widget classes of the registry entries declared for Mode
+    void GetWidgetClassesForMode(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths) const;
+
+    // Background loads of the widget classes declared for Mode, done on every mode change
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    void PreloadUIForMode(EAppMode Mode);
+
+    // Registry entry shown while PushUIAsync waits, None for nothing
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
+    FName AsyncPlaceholderUIName;
+
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    FUIWidgetPoolStats GetWidgetPoolStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "UI")
+    void EmptyWidgetPools();
+
+    // Estimated size of all pooled widgets; the oldest are dropped beyond it
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI", meta = (ClampMin = "0"))
+    float WidgetPoolBudgetMB = 16.0f;
+
     UPROPERTY(BlueprintAssignable, Category = "UI")
     FOnUIPushed OnUIPushed;
 
     UPROPERTY(BlueprintAssignable, Category = "UI")
     FOnUIPopped OnUIPopped;
 
+    // Once per applied batch, after its pushed and popped notifications
+    UPROPERTY(BlueprintAssignable, Category = "UI")
+    FOnUIChangesApplied OnUIChangesApplied;
+
 private:
     UPROPERTY()
     UUIRegistry* UIRegistry;
     UPROPERTY()
-    TMap<EUILayer, UUserWidget*> ActiveWidgets;
+    TObjectPtr<UUIRootWidget> RootWidget;
+
+    UPROPERTY()
+    TMap<EUILayer, FUILayerStack> LayerStacks;
+
+    TSet<EUILayer> HiddenLayers;
+
+    // Pushed with EUIWidgetOwnership::Caller, never pooled
+    TSet<TObjectKey<UUserWidget>> CallerOwnedWidgets;
+
+    // PushUIAsync requests waiting for their class, per layer
+    struct FPendingPush
+    {
+        FName UIName;
+        TWeakObjectPtr<UUserWidget> Placeholder;
+    };
+    TMap<EUILayer, FPendingPush> PendingPushes;
+
+    UPROPERTY()
+    TObjectPtr<UEventBusSubsystem> EventBus;
+
+    FTwinEventHandle ModeChangedHandle;
+
+    UPROPERTY()
+    TMap<FName, FUIWidgetPool> WidgetPools;
+
+    FUIWidgetPoolStats PoolStats;
+    double TotalCreateSeconds = 0.0;
+
+    // Recorded changes
+    enum class EUIIntent : uint8
+    {
+        Push,
+        PushAsync,
+        PushWidget,
+        Pop,
+        Remove,
+        RemoveWidget,
+        PopAll
+    };
+    struct FUIIntent
+    {
+        EUIIntent Type = EUIIntent::Push;
+        FName UIName;
+        EUILayer Layer = EUILayer::HUD;
+        TWeakObjectPtr<UUserWidget> Widget;
+        EUIWidgetOwnership Ownership = EUIWidgetOwnership::Caller;
+    };
+    static bool IsPushIntent(EUIIntent Type)
+    {
+        return Type == EUIIntent::Push || Type == EUIIntent::PushAsync || Type == EUIIntent::PushWidget;
+    }
+    TArray<FUIIntent> Intents;
+    int32 CancelledIntents = 0;
+    int32 TransactionDepth = 0;
+    bool bApplyingIntents = false;
+    FDelegateHandle SlatePreTickHandle;
+
+    // Notifications of the batch being applied, sent once all of it is on screen
+    struct FUINotification
+    {
+        FName UIName;
+        EUILayer Layer = EUILayer::HUD;
+        UUserWidget* Widget = nullptr;
+        bool bPushed = false;
+    };
+    TArray<FUINotification> DeferredNotifications;
+
+    bool RecordIntent(EUIIntent Type, FName UIName, EUILayer Layer, UUserWidget* Widget = nullptr,
+        EUIWidgetOwnership Ownership = EUIWidgetOwnership::Caller);
+    void ApplyIntents();
+    void HandleSlatePreTick(float DeltaTime);
+    void PushUINow(FName UIName, EUILayer Layer);
+    void PushUIAsyncNow(FName UIName, EUILayer Layer);
+    void PushWidgetNow(UUserWidget* Widget, EUILayer Layer, FName UIName, EUIWidgetOwnership Ownership);
+    bool RemoveWidgetNow(UUserWidget* Widget);
+    bool FindWidgetLayer(const UUserWidget* Widget, EUILayer& OutLayer) const;
+    void PopUINow(EUILayer Layer);
+    bool RemoveUINow(FName UIName, EUILayer Layer);
+    void PopAllUINow();
+
+    UUserWidget* ShowWidget(FName UIName, EUILayer Layer, UClass* WidgetClass);
+    void RemoveFromStack(EUILayer Layer, int32 Index, bool bReleaseToPool = true);
+    void ClearPendingPush(EUILayer Layer);
+    void HandleWidgetClassLoaded(FName UIName, EUILayer Layer);
+    void HandleModeChanged(const FModeChangedEvent& Event);
+    UUserWidget* AcquireWidget(FName UIName, UClass* WidgetClass);
+    void ReleaseWidget(FName UIName, UUserWidget* Widget);
+    void EnforceWidgetPoolBudget();
+    static int64 EstimateWidgetBytes(const UUserWidget* Widget);
+
+    void PublishPushed(FName UIName, EUILayer Layer, UUserWidget* Widget);
+    void PublishPopped(EUILayer Layer, UUserWidget* Widget);
 };
@@ -3,6 +3,7 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "TwinPluginFramework/Core/TwinToolInterface.h"
 #include "TwinPluginFramework/Core/TwinPluginRegistry.h"
+#include "Subsystems/EventBusSubsystem.h"
 #include "TwinPluginManager.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnToolRegistered, const FString&, ToolID);
@@ -80,6 +81,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Plugin Manager")
     TArray<FString> GetToolsForCurrentMode() const;
 
+    // Native access to the catalog without copying it, for palettes and search
+    const TArray<FRegisteredTool>& GetRegisteredTools() const;
+    const FRegisteredTool* FindRegisteredTool(const FString& ToolID) const;
+
+    // Tool classes for Mode that are not loaded yet, and the prewarm assets of those that are
+    void GetToolAssetsForMode(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths) const;
+
     // Console Commands
     UFUNCTION(Exec, Category = "Twin Plugin")
     bool ActivateToolCommand(const FString& ToolID);
@@ -103,7 +111,15 @@ protected:
     UPROPERTY()
     EAppMode CurrentMode = EAppMode::MainMenu;
 
+    UPROPERTY()
+    TObjectPtr<UEventBusSubsystem> EventBus;
+
+    FTwinEventHandle ModeChangedHandle;
+
     void LoadRegisteredTools();
     void UnloadAllTools();
+    void UnloadToolsForMode(EAppMode NewMode);
+    void HandleModeChanged(const FModeChangedEvent& Event);
+    void PublishToolEvent(EToolEventType Type, const FString& ToolID, UObject* Tool);
     bool ValidateToolClass(TSubclassOf<UObject> ToolClass) const;
 };
\ No newline at end of file
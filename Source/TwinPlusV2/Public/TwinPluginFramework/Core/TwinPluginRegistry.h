@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
 #include "TwinPluginFramework/Core/TwinToolInterface.h"
+#include "DataAssets/IndexedRegistry.h"
 #include "TwinPluginRegistry.generated.h"
 
 USTRUCT(BlueprintType)
@@ -37,6 +38,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Plugin Registry")
     FRegisteredTool FindTool(const FString& ToolID) const;
 
+    const FRegisteredTool* FindToolEntry(const FString& ToolID) const { return ToolIndex.Find(RegisteredTools, ToolID); }
 
     UFUNCTION(BlueprintCallable, Category = "Plugin Registry")
     TArray<FRegisteredTool> GetToolsByCategory(EToolCategory Category) const;
@@ -49,4 +51,15 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Plugin Registry")
     bool UnregisterTool(const FString& ToolID);
+
+    // Call after changing RegisteredTools directly
+    void RebuildIndex();
+
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    TIndexedRegistry<FRegisteredTool, FString, const FString&> ToolIndex{ [](const FRegisteredTool& Tool) -> const FString& { return Tool.ToolID; } };
 };
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+/**
+ * Type-erased batch of items flowing between pipeline stages.
+ * Use TDataPipelinePayload<T> for the concrete storage.
+ */
+struct FDataPipelinePayload
+{
+    virtual ~FDataPipelinePayload() = default;
+    virtual int32 Num() const = 0;
+    virtual const void* GetTypeId() const = 0;
+};
+
+template <typename ItemType>
+struct TDataPipelinePayload final : public FDataPipelinePayload
+{
+    TArray<ItemType> Items;
+
+    static const void* StaticTypeId()
+    {
+        static const uint8 TypeId = 0;
+        return &TypeId;
+    }
+
+    virtual int32 Num() const override { return Items.Num(); }
+    virtual const void* GetTypeId() const override { return StaticTypeId(); }
+};
+
+/** Unit of work passed through a UDataPipeline queue */
+struct FDataPipelinePacket
+{
+    int64 Sequence = INDEX_NONE;
+    TUniquePtr<FDataPipelinePayload> Payload;
+
+    int32 Num() const { return Payload ? Payload->Num() : 0; }
+
+    template <typename ItemType>
+    static FDataPipelinePacket Make(TArray<ItemType>&& Items)
+    {
+        TUniquePtr<TDataPipelinePayload<ItemType>> Typed = MakeUnique<TDataPipelinePayload<ItemType>>();
+        Typed->Items = MoveTemp(Items);
+
+        FDataPipelinePacket Packet;
+        Packet.Payload = MoveTemp(Typed);
+        return Packet;
+    }
+
+    /** Returns the items if this packet carries ItemType, nullptr otherwise */
+    template <typename ItemType>
+    TArray<ItemType>* GetItems() const
+    {
+        if (!Payload || Payload->GetTypeId() != TDataPipelinePayload<ItemType>::StaticTypeId())
+        {
+            return nullptr;
+        }
+        return &static_cast<TDataPipelinePayload<ItemType>*>(Payload.Get())->Items;
+    }
+};
+
+/** Output side of a pipeline stage, handed to processors while they run */
+class FDataPipelineEmitter
+{
+public:
+    virtual ~FDataPipelineEmitter() = default;
+
+    /** Pushes a packet downstream. Blocks while the downstream queue is full; returns false once cancelled. */
+    virtual bool Emit(FDataPipelinePacket&& Packet) = 0;
+
+    /** Source stages report their own progress (0..1), downstream stages derive theirs from it */
+    virtual void ReportProgress(float Progress) = 0;
+
+    virtual bool IsCancelled() const = 0;
+};
+
+/**
+ * Bounded single-producer/single-consumer ring buffer.
+ * Capacity is rounded up to a power of two. TryPush only consumes the item on success.
+ */
+template <typename T>
+class TDataPipelineQueue
+{
+public:
+    explicit TDataPipelineQueue(uint32 InCapacity)
+        : Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2)))
+        , Mask(Capacity - 1)
+    {
+        Slots.SetNum(Capacity);
+    }
+
+    bool TryPush(T&& Item)
+    {
+        const uint64 Tail = TailIndex.load(std::memory_order_relaxed);
+        if (Tail - HeadIndex.load(std::memory_order_acquire) >= Capacity)
+        {
+            return false;
+        }
+
+        Slots[Tail & Mask] = MoveTemp(Item);
+        TailIndex.store(Tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& OutItem)
+    {
+        const uint64 Head = HeadIndex.load(std::memory_order_relaxed);
+        if (Head == TailIndex.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        OutItem = MoveTemp(Slots[Head & Mask]);
+        HeadIndex.store(Head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        return HeadIndex.load(std::memory_order_acquire) == TailIndex.load(std::memory_order_acquire);
+    }
+
+    int32 Num() const
+    {
+        return static_cast<int32>(TailIndex.load(std::memory_order_acquire) - HeadIndex.load(std::memory_order_acquire));
+    }
+
+    int32 Max() const { return static_cast<int32>(Capacity); }
+
+private:
+    TArray<T> Slots;
+    const uint64 Capacity;
+    const uint64 Mask;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> HeadIndex{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> TailIndex{0};
+};
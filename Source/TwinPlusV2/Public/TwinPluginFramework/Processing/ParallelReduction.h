@@ -0,0 +1,274 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+/**
+ * Parallel Reduction - Deterministic reductions for analysis processors
+ *
+ * Input is split into fixed-size chunks, each chunk is reduced into its own accumulator
+ * without locks, then the partials are merged pairwise in a fixed tree order. The chunk
+ * layout depends only on the input size, so results are bit-identical for any thread count.
+ *
+ * Accumulators are copyable types providing Merge(const T& Other).
+ */
+namespace TwinReduction
+{
+    static constexpr int32 DefaultChunkSize = 4096;
+
+    /** Merges Partials[1..N) into Partials[0] in a fixed pairwise tree */
+    template <typename AccumulatorType>
+    void TreeMerge(TArray<AccumulatorType>& Partials)
+    {
+        const int32 Num = Partials.Num();
+        for (int32 Stride = 1; Stride < Num; Stride *= 2)
+        {
+            const int32 NumPairs = (Num - Stride + 2 * Stride - 1) / (2 * Stride);
+            ParallelFor(NumPairs, [&Partials, Stride, Num](int32 PairIndex)
+            {
+                const int32 Left = PairIndex * 2 * Stride;
+                const int32 Right = Left + Stride;
+                if (Right < Num)
+                {
+                    Partials[Left].Merge(Partials[Right]);
+                }
+            });
+        }
+    }
+
+    /**
+     * Reduces [0, Num) with AccumulateRange(Accumulator, StartIndex, EndIndex).
+     * Each chunk starts from a copy of Prototype.
+     */
+    template <typename AccumulatorType, typename AccumulateRangeFuncType>
+    AccumulatorType ParallelReduce(int32 Num, const AccumulatorType& Prototype, AccumulateRangeFuncType&& AccumulateRange, int32 ChunkSize = DefaultChunkSize)
+    {
+        if (Num <= 0)
+        {
+            return Prototype;
+        }
+
+        ChunkSize = FMath::Max(ChunkSize, 1);
+        const int32 NumChunks = FMath::DivideAndRoundUp(Num, ChunkSize);
+
+        TArray<AccumulatorType> Partials;
+        Partials.Init(Prototype, NumChunks);
+
+        ParallelFor(NumChunks, [&](int32 ChunkIndex)
+        {
+            // Accumulate locally so neighbouring chunks never share a cache line while hot
+            AccumulatorType Local = Prototype;
+            const int32 Start = ChunkIndex * ChunkSize;
+            AccumulateRange(Local, Start, FMath::Min(Start + ChunkSize, Num));
+            Partials[ChunkIndex] = MoveTemp(Local);
+        });
+
+        TreeMerge(Partials);
+        return MoveTemp(Partials[0]);
+    }
+
+    /** Convenience overload for accumulators with Add(Value) over a contiguous array */
+    template <typename AccumulatorType, typename ValueType>
+    AccumulatorType ParallelReduce(TArrayView<const ValueType> Values, const AccumulatorType& Prototype, int32 ChunkSize = DefaultChunkSize)
+    {
+        return ParallelReduce(Values.Num(), Prototype, [Values](AccumulatorType& Accumulator, int32 Start, int32 End)
+        {
+            for (int32 Index = Start; Index < End; ++Index)
+            {
+                Accumulator.Add(Values[Index]);
+            }
+        }, ChunkSize);
+    }
+}
+
+/** Count and sum, accumulated in double precision */
+struct TWINPLUSV2_API FSumAccumulator
+{
+    int64 Count = 0;
+    double Sum = 0.0;
+
+    FORCEINLINE void Add(double Value)
+    {
+        ++Count;
+        Sum += Value;
+    }
+
+    void Merge(const FSumAccumulator& Other)
+    {
+        Count += Other.Count;
+        Sum += Other.Sum;
+    }
+};
+
+struct TWINPLUSV2_API FMinMaxAccumulator
+{
+    int64 Count = 0;
+    double Min = TNumericLimits<double>::Max();
+    double Max = TNumericLimits<double>::Lowest();
+
+    FORCEINLINE void Add(double Value)
+    {
+        ++Count;
+        Min = FMath::Min(Min, Value);
+        Max = FMath::Max(Max, Value);
+    }
+
+    void Merge(const FMinMaxAccumulator& Other)
+    {
+        Count += Other.Count;
+        Min = FMath::Min(Min, Other.Min);
+        Max = FMath::Max(Max, Other.Max);
+    }
+};
+
+/** Numerically stable mean/variance (Welford, merged with Chan's parallel update) */
+struct TWINPLUSV2_API FWelfordAccumulator
+{
+    int64 Count = 0;
+    double Mean = 0.0;
+    double M2 = 0.0;
+
+    FORCEINLINE void Add(double Value)
+    {
+        ++Count;
+        const double Delta = Value - Mean;
+        Mean += Delta / static_cast<double>(Count);
+        M2 += Delta * (Value - Mean);
+    }
+
+    void Merge(const FWelfordAccumulator& Other);
+
+    double GetVariance(bool bSample = false) const;
+    double GetStdDev(bool bSample = false) const { return FMath::Sqrt(GetVariance(bSample)); }
+};
+
+/** Fixed-range histogram with under/overflow counters. Partials must share the same range and bin count. */
+struct TWINPLUSV2_API FHistogramAccumulator
+{
+    double RangeMin = 0.0;
+    double RangeMax = 1.0;
+    int64 Underflow = 0;
+    int64 Overflow = 0;
+    // NaNs, and in-range values of a default constructed histogram that has no bins
+    int64 Dropped = 0;
+    TArray<int64> Bins;
+
+    FHistogramAccumulator() = default;
+    FHistogramAccumulator(double InRangeMin, double InRangeMax, int32 NumBins);
+
+    FORCEINLINE void Add(double Value)
+    {
+        // Infinities land in the under/overflow counters, NaN fails every comparison
+        if (Value < RangeMin)
+        {
+            ++Underflow;
+        }
+        else if (Value >= RangeMax)
+        {
+            ++Overflow;
+        }
+        else if (FMath::IsNaN(Value) || Bins.Num() == 0)
+        {
+            ++Dropped;
+        }
+        else
+        {
+            const int32 Bin = static_cast<int32>((Value - RangeMin) * InvBinWidth);
+            ++Bins[FMath::Min(Bin, Bins.Num() - 1)];
+        }
+    }
+
+    void Merge(const FHistogramAccumulator& Other);
+
+    int64 GetTotalCount() const;
+
+private:
+    double InvBinWidth = 1.0;
+};
+
+/**
+ * Keeps the K largest values according to Predicate (the K smallest with TGreater).
+ * Ties are broken by merge order, which the fixed tree makes deterministic.
+ */
+template <typename ValueType, typename PredicateType = TLess<ValueType>>
+struct TTopKAccumulator
+{
+    int32 K = 10;
+    TArray<ValueType> Heap;
+
+    TTopKAccumulator() = default;
+    explicit TTopKAccumulator(int32 InK) : K(FMath::Max(InK, 1)) {}
+
+    void Add(const ValueType& Value)
+    {
+        // Heap is ordered so its top is the weakest kept element
+        const auto WeakestFirst = [](const ValueType& A, const ValueType& B) { return PredicateType()(A, B); };
+        if (Heap.Num() < K)
+        {
+            Heap.HeapPush(Value, WeakestFirst);
+        }
+        else if (PredicateType()(Heap.HeapTop(), Value))
+        {
+            Heap.HeapPopDiscard(WeakestFirst);
+            Heap.HeapPush(Value, WeakestFirst);
+        }
+    }
+
+    void Merge(const TTopKAccumulator& Other)
+    {
+        for (const ValueType& Value : Other.Heap)
+        {
+            Add(Value);
+        }
+    }
+
+    /** Kept values, strongest first */
+    TArray<ValueType> GetSorted() const
+    {
+        TArray<ValueType> Sorted = Heap;
+        Sorted.Sort([](const ValueType& A, const ValueType& B) { return PredicateType()(B, A); });
+        return Sorted;
+    }
+};
+
+/**
+ * Relative-error quantile sketch (DDSketch layout). Values map to logarithmic buckets,
+ * so merging is plain count addition and independent of order.
+ */
+struct TWINPLUSV2_API FQuantileSketch
+{
+    FQuantileSketch() : FQuantileSketch(0.01) {}
+    explicit FQuantileSketch(double InRelativeAccuracy);
+
+    void Add(double Value);
+    void Merge(const FQuantileSketch& Other);
+
+    /** Quantile in [0, 1], within RelativeAccuracy of the true value */
+    double GetQuantile(double Quantile) const;
+
+    int64 GetCount() const { return Count; }
+    // NaNs and infinities, they have no bucket and are not part of Count
+    int64 GetDroppedCount() const { return Dropped; }
+    double GetRelativeAccuracy() const { return RelativeAccuracy; }
+
+private:
+    struct FBucketStore
+    {
+        int32 MinIndex = 0;
+        TArray<int64> Counts;
+
+        void Increment(int32 Index, int64 Amount);
+        void Merge(const FBucketStore& Other);
+    };
+
+    double RelativeAccuracy = 0.01;
+    double Gamma = 1.0;
+    double InvLogGamma = 1.0;
+    int64 Count = 0;
+    int64 ZeroCount = 0;
+    int64 Dropped = 0;
+    FBucketStore Positive;
+    FBucketStore Negative;
+
+    int32 GetBucketIndex(double AbsValue) const;
+    double GetBucketValue(int32 Index) const;
+};
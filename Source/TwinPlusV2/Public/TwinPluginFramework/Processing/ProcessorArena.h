@@ -0,0 +1,200 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+
+/**
+ * Processor Arena - Linear scratch allocator for batch processing
+ *
+ * Allocations bump a pointer inside large chunks and are released in bulk with
+ * PopToMark()/Reset(). Chunks are kept across resets, so a job that has reached its
+ * peak footprint stops calling into the global allocator entirely.
+ *
+ * Destructors are never run for arena memory; only store trivially destructible data
+ * or containers using TProcessorArenaAllocator.
+ */
+class TWINPLUSV2_API FProcessorArena
+{
+public:
+    struct FMark
+    {
+        int32 ChunkIndex = 0;
+        SIZE_T Offset = 0;
+        SIZE_T UsedBeforeChunk = 0;
+    };
+
+    explicit FProcessorArena(SIZE_T InChunkSize = 256 * 1024);
+    ~FProcessorArena();
+
+    FProcessorArena(const FProcessorArena&) = delete;
+    FProcessorArena& operator=(const FProcessorArena&) = delete;
+
+    void* Allocate(SIZE_T Size, uint32 Alignment = DEFAULT_ALIGNMENT);
+
+    template <typename T, typename... ArgTypes>
+    T* New(ArgTypes&&... Args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destructed");
+        return new (Allocate(sizeof(T), alignof(T))) T(Forward<ArgTypes>(Args)...);
+    }
+
+    FMark GetMark() const { return FMark{CurrentChunk, Offset, UsedBeforeChunk}; }
+    void PopToMark(const FMark& Mark);
+    void Reset() { PopToMark(FMark()); }
+
+    // Frees chunks beyond the current position
+    void Trim();
+
+    // Stats
+    SIZE_T GetBytesUsed() const { return UsedBeforeChunk + Offset; }
+    SIZE_T GetPeakBytesUsed() const { return PeakBytesUsed; }
+    SIZE_T GetBytesReserved() const { return BytesReserved; }
+    int32 GetChunkAllocations() const { return ChunkAllocations; }
+    int64 GetAllocationCount() const { return AllocationCount; }
+    void ResetStats();
+
+    // Arena used by TProcessorArenaAllocator on this thread, set through FProcessorArenaScope
+    static FProcessorArena* GetCurrent();
+
+    // Lazily created arena owned by the calling worker thread
+    static FProcessorArena& GetThreadArena();
+
+private:
+    friend class FProcessorArenaScope;
+
+    struct FChunk
+    {
+        uint8* Data = nullptr;
+        SIZE_T Size = 0;
+    };
+
+    TArray<FChunk> Chunks;
+    SIZE_T ChunkSize;
+    int32 CurrentChunk = 0;
+    SIZE_T Offset = 0;
+    SIZE_T UsedBeforeChunk = 0;
+
+    SIZE_T PeakBytesUsed = 0;
+    SIZE_T BytesReserved = 0;
+    int32 ChunkAllocations = 0;
+    int64 AllocationCount = 0;
+};
+
+/**
+ * Makes an arena current on this thread and releases everything allocated
+ * through it when the scope ends.
+ */
+class TWINPLUSV2_API FProcessorArenaScope
+{
+public:
+    explicit FProcessorArenaScope(FProcessorArena& InArena);
+    ~FProcessorArenaScope();
+
+    FProcessorArenaScope(const FProcessorArenaScope&) = delete;
+    FProcessorArenaScope& operator=(const FProcessorArenaScope&) = delete;
+
+private:
+    FProcessorArena& Arena;
+    FProcessorArena* PreviousArena;
+    FProcessorArena::FMark Mark;
+};
+
+/**
+ * TArray-compatible allocator drawing from the thread's current FProcessorArena.
+ * Containers must not outlive the FProcessorArenaScope they were filled in.
+ */
+template <uint32 Alignment = DEFAULT_ALIGNMENT>
+class TProcessorArenaAllocator
+{
+public:
+    using SizeType = int32;
+
+    enum { NeedsElementType = false };
+    enum { RequireRangeCheck = true };
+
+    class ForAnyElementType
+    {
+    public:
+        ForAnyElementType() = default;
+
+        FORCEINLINE void MoveToEmpty(ForAnyElementType& Other)
+        {
+            checkSlow(this != &Other);
+            Data = Other.Data;
+            Other.Data = nullptr;
+        }
+
+        FORCEINLINE FScriptContainerElement* GetAllocation() const
+        {
+            return Data;
+        }
+
+        void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement)
+        {
+            FScriptContainerElement* OldData = Data;
+            Data = nullptr;
+
+            if (NewMax > 0)
+            {
+                FProcessorArena* Arena = FProcessorArena::GetCurrent();
+                checkf(Arena, TEXT("TProcessorArenaAllocator used outside of an FProcessorArenaScope"));
+
+                Data = static_cast<FScriptContainerElement*>(Arena->Allocate(NewMax * NumBytesPerElement, Alignment));
+                if (OldData && CurrentNum > 0)
+                {
+                    FMemory::Memcpy(Data, OldData, FMath::Min(NewMax, CurrentNum) * NumBytesPerElement);
+                }
+            }
+        }
+
+        FORCEINLINE SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement) const
+        {
+            return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false, Alignment);
+        }
+
+        FORCEINLINE SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false, Alignment);
+        }
+
+        FORCEINLINE SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false, Alignment);
+        }
+
+        SIZE_T GetAllocatedSize(SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+        {
+            return CurrentMax * NumBytesPerElement;
+        }
+
+        bool HasAllocation() const
+        {
+            return Data != nullptr;
+        }
+
+        SizeType GetInitialCapacity() const
+        {
+            return 0;
+        }
+
+    private:
+        FScriptContainerElement* Data = nullptr;
+    };
+
+    template <typename ElementType>
+    class ForElementType : public ForAnyElementType
+    {
+    public:
+        FORCEINLINE ElementType* GetAllocation() const
+        {
+            return reinterpret_cast<ElementType*>(ForAnyElementType::GetAllocation());
+        }
+    };
+};
+
+template <uint32 Alignment>
+struct TAllocatorTraits<TProcessorArenaAllocator<Alignment>> : TAllocatorTraitsBase<TProcessorArenaAllocator<Alignment>>
+{
+};
+
+template <typename ElementType>
+using TProcessorArenaArray = TArray<ElementType, TProcessorArenaAllocator<>>;
@@ -0,0 +1,89 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "SensorKernels.generated.h"
+
+/**
+ * Sensor Kernels - Vectorized passes over contiguous float buffers
+ *
+ * Built on Unreal's VectorRegister4Float (SSE on x64, NEON on ARM, FPU emulation elsewhere).
+ * Every kernel has a scalar reference in TwinKernels::Scalar with the same signature;
+ * "Twin.Kernels.Bench" compares the two.
+ *
+ * Elementwise kernels allow Out to alias In. Out must be at least as large as In unless noted.
+ */
+namespace TwinKernels
+{
+    struct FKernelStats
+    {
+        float Min = 0.0f;
+        float Max = 0.0f;
+        double Mean = 0.0;
+        int32 Count = 0;
+    };
+
+    // Out = In * Scale + Offset (unit conversion)
+    TWINPLUSV2_API void ScaleOffset(TArrayView<const float> In, TArrayView<float> Out, float Scale, float Offset);
+    TWINPLUSV2_API void Clamp(TArrayView<const float> In, TArrayView<float> Out, float MinValue, float MaxValue);
+
+    // Out = 1 where In > Threshold, 0 otherwise
+    TWINPLUSV2_API void ThresholdMask(TArrayView<const float> In, TArrayView<float> Out, float Threshold);
+    TWINPLUSV2_API int32 CountAbove(TArrayView<const float> In, float Threshold);
+
+    // Trailing window average, the first Window-1 samples average what is available
+    TWINPLUSV2_API void MovingAverage(TArrayView<const float> In, TArrayView<float> Out, int32 Window);
+
+    // Forward difference per second, the last sample repeats the previous slope
+    TWINPLUSV2_API void Derivative(TArrayView<const float> In, TArrayView<float> Out, float SampleInterval);
+
+    TWINPLUSV2_API FKernelStats ComputeStats(TArrayView<const float> In);
+
+    // Linear resample of In onto Out.Num() evenly spaced samples
+    TWINPLUSV2_API void ResampleLinear(TArrayView<const float> In, TArrayView<float> Out);
+
+    namespace Scalar
+    {
+        TWINPLUSV2_API void ScaleOffset(TArrayView<const float> In, TArrayView<float> Out, float Scale, float Offset);
+        TWINPLUSV2_API void Clamp(TArrayView<const float> In, TArrayView<float> Out, float MinValue, float MaxValue);
+        TWINPLUSV2_API void ThresholdMask(TArrayView<const float> In, TArrayView<float> Out, float Threshold);
+        TWINPLUSV2_API int32 CountAbove(TArrayView<const float> In, float Threshold);
+        TWINPLUSV2_API void MovingAverage(TArrayView<const float> In, TArrayView<float> Out, int32 Window);
+        TWINPLUSV2_API void Derivative(TArrayView<const float> In, TArrayView<float> Out, float SampleInterval);
+        TWINPLUSV2_API FKernelStats ComputeStats(TArrayView<const float> In);
+        TWINPLUSV2_API void ResampleLinear(TArrayView<const float> In, TArrayView<float> Out);
+    }
+}
+
+/**
+ * Blueprint batch nodes for the sensor kernels
+ */
+UCLASS()
+class TWINPLUSV2_API UTwinKernelLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintCallable, Category = "Twin Kernels")
+    static TArray<float> ScaleOffset(const TArray<float>& Samples, float Scale = 1.0f, float Offset = 0.0f);
+
+    UFUNCTION(BlueprintCallable, Category = "Twin Kernels")
+    static TArray<float> ClampSamples(const TArray<float>& Samples, float MinValue, float MaxValue);
+
+    UFUNCTION(BlueprintCallable, Category = "Twin Kernels")
+    static TArray<float> ThresholdMask(const TArray<float>& Samples, float Threshold);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Twin Kernels")
+    static int32 CountAbove(const TArray<float>& Samples, float Threshold);
+
+    UFUNCTION(BlueprintCallable, Category = "Twin Kernels")
+    static TArray<float> MovingAverage(const TArray<float>& Samples, int32 Window = 8);
+
+    UFUNCTION(BlueprintCallable, Category = "Twin Kernels")
+    static TArray<float> Derivative(const TArray<float>& Samples, float SampleInterval = 1.0f);
+
+    UFUNCTION(BlueprintCallable, Category = "Twin Kernels")
+    static void ComputeStats(const TArray<float>& Samples, float& Min, float& Max, float& Mean);
+
+    UFUNCTION(BlueprintCallable, Category = "Twin Kernels")
+    static TArray<float> ResampleLinear(const TArray<float>& Samples, int32 NumOutputSamples);
+};
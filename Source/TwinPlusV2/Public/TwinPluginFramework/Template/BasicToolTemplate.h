@@ -39,6 +39,14 @@ public:
     virtual UUserWidget* CreateToolWidget_Implementation();
     virtual void OnModeChanged_Implementation(EAppMode NewMode);
 
+    // Assets the tool needs in Mode, streamed in before a mode transition commits
+    virtual void GetPrewarmAssets(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths) const;
+
+    // ID the plugin manager created the tool under, also the topic of its bus events.
+    // Empty for tools created elsewhere, those publish without a topic.
+    const FString& GetToolID() const { return ToolID; }
+    void SetToolID(const FString& InToolID);
+
 protected:
     // Tool State
     UPROPERTY(BlueprintReadOnly, Category = "Tool State")
@@ -100,4 +108,7 @@ protected:
 private:
     UPROPERTY()
     TObjectPtr<UUserWidget> CachedWidget;
+
+    FString ToolID;
+    FName ToolTopic;
 };
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "CoreMinimal.h"
 #include "TwinPluginFramework/Template/BasicToolTemplate.h"
 #include "Engine/LatentActionManager.h"
+#include "Async/Future.h"
+#include "TwinPluginFramework/Pipeline/DataPipelineTypes.h"
+#include "TwinPluginFramework/Processing/ProcessorArena.h"
 #include "DataProcessorTemplate.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDataProcessingComplete, bool, bSuccess, const FString&, Result);
@@ -15,6 +18,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDataProcessingProgress, float, P
  * - Progress tracking
  * - Cancellation support
  * - Batch processing capabilities
+ * - Checkpoint/resume for long-running jobs
+ * - Per-job scratch arena, current during ProcessDataBatch and reset after every batch
+ * - Native processors override the _Implementation of the processing events
+ * - Can run as a stage of a UDataPipeline (native only)
  */
 UCLASS(BlueprintType, Blueprintable, Abstract)
 class TWINPLUSV2_API UDataProcessorTemplate : public UBasicToolTemplate
@@ -33,7 +40,7 @@ public:
 
     // Processing Control
     UFUNCTION(BlueprintCallable, Category = "Data Processing")
-    void StartProcessing();
+    void StartProcessing(bool bResumeFromCheckpoint = false);
 
     UFUNCTION(BlueprintCallable, Category = "Data Processing")
     void CancelProcessing();
@@ -53,6 +60,31 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Data Processing")
     float GetProgress() const { return CurrentProgress; }
 
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Data Processing")
+    int64 GetArenaPeakBytes() const;
+
+    // Checkpointing
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Data Processing|Checkpoint")
+    bool HasCheckpoint() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Data Processing|Checkpoint")
+    void DeleteCheckpoint();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Data Processing|Checkpoint")
+    FString GetCheckpointFilePath() const;
+
+    virtual void BeginDestroy() override;
+
+    // Pipeline Stage Hooks - native only, called on the stage's worker thread
+    // Source stage: emit packets until done. Returning false fails the pipeline.
+    virtual bool ProducePipelinePackets(FDataPipelineEmitter& Emitter);
+
+    // Downstream stage: transform one input packet. The default forwards it unchanged.
+    virtual bool ProcessPipelinePacket(FDataPipelinePacket&& Packet, FDataPipelineEmitter& Emitter);
+
+    // Called once after the last input packet, aggregating stages emit their result here
+    virtual bool FlushPipelineStage(FDataPipelineEmitter& Emitter);
+
 protected:
     // Processing State
     UPROPERTY(BlueprintReadOnly, Category = "Processing State")
@@ -77,19 +109,44 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Processing Config")
     bool bShowProgressUI = true;
 
+    // Chunk size of the per-job scratch arena
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Processing Config", meta = (ClampMin = "4"))
+    int32 ArenaChunkSizeKB = 256;
+
+    // Checkpoint Configuration
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Processing Config|Checkpoint")
+    bool bEnableCheckpoints = false;
+
+    // Completed batches between checkpoint writes
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Processing Config|Checkpoint", meta = (ClampMin = "1", EditCondition = "bEnableCheckpoints"))
+    int32 CheckpointInterval = 50;
+
+    // File name under Saved/Checkpoints. When empty the plugin manager's tool ID is used, or the class
+    // and tool name for processors created elsewhere; set it when two such processors share both.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Processing Config|Checkpoint", meta = (EditCondition = "bEnableCheckpoints"))
+    FString CheckpointName;
+
     // Virtual Processing Functions
-    UFUNCTION(BlueprintImplementableEvent, Category = "Data Processing")
+    UFUNCTION(BlueprintNativeEvent, Category = "Data Processing")
     void InitializeProcessing();
 
-    UFUNCTION(BlueprintImplementableEvent, Category = "Data Processing")
+    // Runs with the batch arena current, in Blueprint and in native overrides
+    UFUNCTION(BlueprintNativeEvent, Category = "Data Processing")
     void ProcessDataBatch(int32 BatchIndex);
 
-    UFUNCTION(BlueprintImplementableEvent, Category = "Data Processing")
+    UFUNCTION(BlueprintNativeEvent, Category = "Data Processing")
     void FinalizeProcessing();
 
-    UFUNCTION(BlueprintImplementableEvent, Category = "Data Processing")
+    UFUNCTION(BlueprintNativeEvent, Category = "Data Processing")
     int32 GetTotalBatches() const;
 
+    // Checkpoint Serialization - called on the game thread, keep the payload compact
+    UFUNCTION(BlueprintNativeEvent, Category = "Data Processing|Checkpoint")
+    void SaveCheckpointState(TArray<uint8>& OutState);
+
+    UFUNCTION(BlueprintNativeEvent, Category = "Data Processing|Checkpoint")
+    bool LoadCheckpointState(const TArray<uint8>& State);
+
     // Progress Updates
     UFUNCTION(BlueprintCallable, Category = "Data Processing")
     void UpdateProgress(float Progress, const FString& Status = TEXT(""));
@@ -97,12 +154,23 @@ protected:
     UFUNCTION(BlueprintCallable, Category = "Data Processing")
     void CompleteProcessing(bool bSuccess, const FString& Result = TEXT(""));
 
+    // Scratch arena for the running job; TProcessorArenaArray allocations made in ProcessDataBatch land here
+    FProcessorArena* GetBatchArena() const { return BatchArena.Get(); }
+
 private:
     FTimerHandle ProcessingTimer;
     int32 CurrentBatch = 0;
     int32 TotalBatches = 0;
 
+    int32 BatchesSinceCheckpoint = 0;
+    TUniquePtr<FProcessorArena> BatchArena;
+    TFuture<bool> PendingCheckpointWrite;
+
     void ProcessNextBatch();
-    void InternalStartProcessing();
+    void InternalStartProcessing(bool bResumeFromCheckpoint);
     void InternalCompleteProcessing(bool bSuccess, const FString& Result);
+
+    void WriteCheckpoint(bool bForce);
+    void WaitForPendingCheckpoint();
+    bool ReadCheckpoint(int32& OutBatch, TArray<uint8>& OutState) const;
 };
\ No newline at end of file
@@ -26,6 +26,7 @@ public:
     virtual void DeactivateTool_Implementation() override;
     virtual UUserWidget* CreateToolWidget_Implementation() override;
     virtual void OnModeChanged_Implementation(EAppMode NewMode) override;
+    virtual void GetPrewarmAssets(EAppMode Mode, TArray<FSoftObjectPath>& OutPaths) const override;
 
 protected:
     // UI Configuration
@@ -51,7 +52,8 @@ protected:
     UFUNCTION(BlueprintImplementableEvent, Category = "UI Events")
     void OnUIWidgetCreated(UUserWidget* Widget);
 
-    // UI Management
+    // UI Management. A widget class that is not resident yet is loaded in the background
+    // and the UI shown once it arrived, unless it was hidden or the tool deactivated meanwhile.
     UFUNCTION(BlueprintCallable, Category = "UI Management")
     void ShowToolUI();
 
@@ -66,5 +68,19 @@ protected:
 
 private:
     bool bUIVisible = false;
+    bool bShowPending = false;
+
+    // Widget classes whose background load came back empty, not requested again
+    TSet<FSoftObjectPath> FailedWidgetClasses;
+
+    UPROPERTY()
+    TMap<EAppMode, TObjectPtr<UUserWidget>> ModeWidgets;
+
+    // The widget on the UI manager's layer while the UI is visible
+    UPROPERTY()
+    TObjectPtr<UUserWidget> ShownWidget;
+
     void UpdateUIForMode(EAppMode Mode);
+    const TSoftClassPtr<UUserWidget>& GetWidgetClassForMode(EAppMode Mode) const;
+    void HandleWidgetClassLoaded(EAppMode Mode);
 };
\ No newline at end of file
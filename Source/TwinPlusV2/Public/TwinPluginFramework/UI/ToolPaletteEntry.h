@@ -0,0 +1,62 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "TwinPluginFramework/Core/TwinToolInterface.h"
+#include "ToolPaletteEntry.generated.h"
+
+class UImage;
+class UTextBlock;
+
+// One tool of the palette, kept for as long as the tool is registered
+UCLASS(BlueprintType)
+class TWINPLUSV2_API UToolPaletteItem : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    FString ToolID;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    FToolMetadata Metadata;
+};
+
+/**
+ * Row or tile of UToolPaletteWidget. The list view only creates as many of these as
+ * fit on screen and hands them new items while scrolling.
+ *
+ * Blueprint subclasses bind NameText and IconImage; the native class builds a plain
+ * icon and name row. Icons come from the icon atlas (UIconManagerSubsystem) and the
+ * image stays hidden until its icon is packed.
+ */
+UCLASS(Blueprintable)
+class TWINPLUSV2_API UToolPaletteEntryWidget : public UUserWidget, public IUserObjectListEntry
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Tools")
+    UToolPaletteItem* GetToolItem() const { return Item; }
+
+protected:
+    virtual TSharedRef<SWidget> RebuildWidget() override;
+    virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+    virtual void NativeOnEntryReleased() override;
+
+    UFUNCTION(BlueprintImplementableEvent, Category = "Tools")
+    void OnToolItemSet(UToolPaletteItem* ToolItem);
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools", meta = (BindWidgetOptional))
+    TObjectPtr<UTextBlock> NameText;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools", meta = (BindWidgetOptional))
+    TObjectPtr<UImage> IconImage;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Tools")
+    FVector2D IconSize = FVector2D(24.0f, 24.0f);
+
+private:
+    UPROPERTY()
+    TObjectPtr<UToolPaletteItem> Item;
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Subsystems/EventBusSubsystem.h"
+#include "TwinPluginFramework/Core/TwinPluginRegistry.h"
+#include "TwinPluginFramework/UI/ToolSearchIndex.h"
+#include "ToolPaletteWidget.generated.h"
+
+class UListView;
+class UToolPaletteItem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPaletteToolPicked, const FString&, ToolID);
+
+/**
+ * Searchable palette of every enabled tool of the plugin registry.
+ *
+ * Tools are shown in a list or tile view that only creates widgets for the visible
+ * entries (see UToolPaletteEntryWidget), so the catalog size does not matter to
+ * layout and paint. Search runs on FToolSearchIndex. Registrations and
+ * unregistrations after construction update single items and refilter once per
+ * frame instead of rebuilding the palette.
+ *
+ * Blueprint subclasses bind their own ToolList (a UListView or UTileView); the native
+ * class builds one.
+ */
+UCLASS(Blueprintable)
+class TWINPLUSV2_API UToolPaletteWidget : public UUserWidget
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintCallable, Category = "Tools")
+    void SetSearchText(const FString& Text);
+
+    UFUNCTION(BlueprintCallable, Category = "Tools")
+    void SetCategoryFilter(EToolCategory Category);
+
+    UFUNCTION(BlueprintCallable, Category = "Tools")
+    void ClearCategoryFilter();
+
+    // Reads the whole catalog again, only needed if the registry was changed without events
+    UFUNCTION(BlueprintCallable, Category = "Tools")
+    void RebuildCatalog();
+
+    // Shows these tools instead of the plugin registry's, e.g. a synthetic catalog for Twin.Tools.PaletteBench
+    void SetCatalog(const TArray<FRegisteredTool>& Tools);
+
+    UListView* GetToolList() const { return ToolList; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Tools")
+    int32 GetShownToolCount() const { return ShownItems.Num(); }
+
+    UFUNCTION(BlueprintCallable, Category = "Tools")
+    FToolSearchStats GetSearchStats() const { return SearchIndex.GetStats(); }
+
+    UPROPERTY(BlueprintAssignable, Category = "Tools")
+    FOnPaletteToolPicked OnToolPicked;
+
+    // Used when the native class builds the list, UToolPaletteEntryWidget by default
+    UPROPERTY(EditDefaultsOnly, Category = "Tools")
+    TSubclassOf<UUserWidget> EntryWidgetClass;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Tools")
+    bool bUseTileView = false;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Tools", meta = (EditCondition = "bUseTileView"))
+    FVector2D TileSize = FVector2D(96.0f, 96.0f);
+
+    // Activate the tool through the plugin manager when its entry is clicked
+    UPROPERTY(EditDefaultsOnly, Category = "Tools")
+    bool bActivateOnClick = true;
+
+protected:
+    virtual TSharedRef<SWidget> RebuildWidget() override;
+    virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
+    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools", meta = (BindWidgetOptional))
+    TObjectPtr<UListView> ToolList;
+
+private:
+    FToolSearchIndex SearchIndex;
+
+    // By search index slot
+    UPROPERTY()
+    TArray<TObjectPtr<UToolPaletteItem>> Items;
+
+    // Current filter result, the objects are held by Items
+    TArray<UObject*> ShownItems;
+
+    FString SearchText;
+    TOptional<EToolCategory> CategoryFilter;
+    bool bFilterDirty = true;
+
+    FTwinEventHandle ToolEventHandle;
+
+    void SetTool(const FRegisteredTool& Tool);
+    void RemoveTool(const FString& ToolID);
+    void ApplyFilter();
+    void HandleToolEvent(const FToolEvent& Event);
+    void HandleItemClicked(UObject* ClickedItem);
+};
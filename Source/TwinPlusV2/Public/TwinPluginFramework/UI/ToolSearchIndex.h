@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TwinPluginFramework/Core/TwinToolInterface.h"
+#include "ToolSearchIndex.generated.h"
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FToolSearchStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    int32 IndexedTools = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    int32 Trigrams = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    int64 MemoryBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    int32 Searches = 0;
+
+    // Searches that only filtered the results of a shorter query
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    int32 NarrowedSearches = 0;
+
+    // Searches answered from the result cache, e.g. after a backspace
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    int32 CachedSearches = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    float LastSearchMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools")
+    float MaxSearchMs = 0.0f;
+};
+
+/**
+ * Text search over tool names and descriptions for catalogs of thousands of tools.
+ *
+ * A tool matches when its name or description contains every whitespace separated
+ * term of the query, case-insensitive. Terms of three or more characters are looked
+ * up through trigram posting lists; a query extending an earlier one only filters
+ * that query's results, so typing narrows instead of searching again. Results are
+ * ordered by where the terms hit the name, then by priority (higher first) and name.
+ */
+class TWINPLUSV2_API FToolSearchIndex
+{
+public:
+    // Replaces the entry of the same tool; returns the tool's slot
+    int32 Add(const FString& ToolID, const FToolMetadata& Metadata);
+    bool Remove(const FString& ToolID);
+    void Reset();
+
+    // Slots of the matching tools, best first. An empty query returns every tool.
+    void Search(const FString& Query, TArray<int32>& OutSlots);
+
+    int32 FindSlot(const FString& ToolID) const
+    {
+        const int32* Slot = SlotsByID.Find(ToolID);
+        return Slot ? *Slot : INDEX_NONE;
+    }
+    const FString& GetToolID(int32 Slot) const { return Entries[Slot].ToolID; }
+    int32 Num() const { return SlotsByID.Num(); }
+
+    FToolSearchStats GetStats() const;
+
+private:
+    struct FEntry
+    {
+        FString ToolID;
+        // Lower case name, a line break and the lower case description
+        FString Text;
+        int32 NameLength = 0;
+        int32 Priority = 0;
+        TArray<uint64> Trigrams;
+    };
+
+    struct FCachedSearch
+    {
+        FString Query;
+        TArray<int32> Slots;
+    };
+
+    static void GetTrigrams(const FString& Text, TArray<uint64>& OutTrigrams);
+    bool MatchesAll(const FEntry& Entry, const TArray<FString>& Terms) const;
+    int32 ScoreName(const FEntry& Entry, const TArray<FString>& Terms) const;
+    void SortResults(TArray<int32>& Slots, const TArray<FString>& Terms);
+    void EnsureRanked();
+    void Invalidate();
+
+    TArray<FEntry> Entries;
+    TArray<int32> FreeSlots;
+    TMap<FString, int32> SlotsByID;
+
+    // Sorted slots per trigram
+    TMap<uint64, TArray<int32>> Postings;
+
+    // Every used slot by priority and name, and each slot's position in it
+    TArray<int32> Ranked;
+    TArray<int32> RankOfSlot;
+    bool bRankDirty = true;
+
+    // Most recent last, dropped on every catalog change
+    TArray<FCachedSearch> Cache;
+    static constexpr int32 MaxCachedSearches = 16;
+
+    int32 Searches = 0;
+    int32 NarrowedSearches = 0;
+    int32 CachedSearches = 0;
+    double LastSearchSeconds = 0.0;
+    double MaxSearchSeconds = 0.0;
+};
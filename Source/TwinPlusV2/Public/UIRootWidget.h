@@ -0,0 +1,93 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Core/UILayer.h"
+#include "UIRootWidget.generated.h"
+
+class UOverlay;
+
+UENUM(BlueprintType)
+enum class EUILayerCaching : uint8
+{
+    None         UMETA(DisplayName = "None"),
+    // Slate caches the layer's widget tree until something in it changes
+    Invalidation UMETA(DisplayName = "Invalidation Box"),
+    // The layer is rendered to a target, optionally every Nth frame
+    Retainer     UMETA(DisplayName = "Retainer Box")
+};
+
+USTRUCT(BlueprintType)
+struct TWINPLUSV2_API FUILayerSettings
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI")
+    EUILayerCaching Caching = EUILayerCaching::None;
+
+    // Only the top widget of the layer is laid out and painted
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI")
+    bool bCollapseCoveredWidgets = true;
+
+    // Retainer layers are redrawn every RetainerPhaseCount frames
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI", meta = (ClampMin = "1"))
+    int32 RetainerPhaseCount = 1;
+};
+
+USTRUCT()
+struct FUIRootLayer
+{
+    GENERATED_BODY()
+
+    // Child of the root overlay: the stack itself or the caching box around it
+    UPROPERTY()
+    TObjectPtr<UWidget> Container;
+
+    // Bottom to top
+    UPROPERTY()
+    TObjectPtr<UOverlay> Stack;
+
+    bool bHidden = false;
+
+    // Visibility of covered widgets before they were collapsed
+    TMap<TObjectKey<UWidget>, ESlateVisibility> CoveredVisibility;
+};
+
+/**
+ * The one viewport widget of UUIManagerSubsystem.
+ *
+ * Every EUILayer is an overlay stacked in enum order on a root overlay. Empty and
+ * hidden layers are collapsed, so Slate skips their prepass and paint, as are
+ * widgets covered by a later push when the layer asks for it. Layers can be put
+ * into an invalidation or retainer box; subclasses configure that per layer.
+ */
+UCLASS(Blueprintable)
+class TWINPLUSV2_API UUIRootWidget : public UUserWidget
+{
+    GENERATED_BODY()
+
+public:
+    UUIRootWidget(const FObjectInitializer& ObjectInitializer);
+
+    void AddToLayer(EUILayer Layer, UUserWidget* Widget);
+    void RemoveFromLayer(EUILayer Layer, UUserWidget* Widget);
+
+    void SetLayerHidden(EUILayer Layer, bool bHidden);
+    bool IsLayerHidden(EUILayer Layer) const;
+
+    // Widgets not collapsed by their layer, for comparing against the stack depth
+    int32 GetPaintedWidgetCount(EUILayer Layer) const;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+    TMap<EUILayer, FUILayerSettings> LayerSettings;
+
+protected:
+    virtual TSharedRef<SWidget> RebuildWidget() override;
+
+private:
+    UPROPERTY()
+    TMap<EUILayer, FUIRootLayer> Layers;
+
+    void BuildLayers();
+    FUIRootLayer* FindLayer(EUILayer Layer);
+    void UpdateLayer(EUILayer Layer);
+};
@@ -12,6 +12,9 @@ public class TwinPlusV2 : ModuleRules
 
         PrivateIncludePaths.AddRange(new[] {""});
 
+        // Icon atlas drawing
+        PrivateDependencyModuleNames.AddRange(new string[] { "RHI", "RenderCore" });
+
         // Uncomment if you are using Slate UI
         // PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 